@@ -1,26 +1,31 @@
-%%writefile dijkstra_tracked.h
+// DijkstraTracked.h
 #ifndef DIJKSTRA_TRACKED_H
 #define DIJKSTRA_TRACKED_H
 
 #include <vector>
 #include <limits>
 #include <chrono>
+#include <utility>
 #include "graph.h"
 #include "priority_queue.h"
 #include "dijkstra.h"
 
+// Calls cb(pq, step, metrics) every sampleEvery extract-mins and once at the
+// end. The callback runs inside the timed loop, so it should only copy the
+// heap's O(1) counters out; pass a HeapEvolutionSampler to have the samples
+// written to disk by a background thread.
 template <typename PQType, typename Callback>
 DijkstraResult runDijkstraTracked(
     const Graph& g,
     int source,
     DijkstraMetrics& metrics,
-    Callback cb,
+    Callback&& cb,
     long long sampleEvery = 1000
 ) {
     int n = g.numVertices();
-    std::vector<double> dist(n, std::numeric_limits<double>::infinity());
-    std::vector<int> parent(n, -1);
-    std::vector<PQNodeBase*> handles(n, nullptr);
+    DijkstraBuffer<double> dist(n, std::numeric_limits<double>::infinity());
+    DijkstraBuffer<int> parent(n, -1);
+    DijkstraBuffer<PQNodeBase*> handles(n, nullptr);
 
     PQType pq;
     auto start = std::chrono::high_resolution_clock::now();
@@ -67,7 +72,7 @@ DijkstraResult runDijkstraTracked(
     // final sample
     cb(pq, step, metrics);
 
-    return DijkstraResult{dist, parent};
+    return DijkstraResult{std::move(dist), std::move(parent)};
 }
 
 #endif // DIJKSTRA_TRACKED_H
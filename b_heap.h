@@ -0,0 +1,235 @@
+// b_heap.h
+#ifndef B_HEAP_H
+#define B_HEAP_H
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include "priority_queue.h"
+#include "node_pool.h"
+
+class BHeapNode : public PQNodeBase {
+public:
+    int value;
+    uint32_t pos;   // physical slot in the B-heap array
+    bool inHeap;
+
+    BHeapNode(int v, uint32_t p) : value(v), pos(p), inHeap(true) {}
+};
+
+// Indexed binary heap in a blocked ("B-heap") layout, after Kamp's B-heap.
+// The implicit tree is cut into complete subtrees of height H, each stored
+// contiguously in a block of 2^H slots (slot 0 of a block is unused). A
+// sift therefore covers H levels per block instead of touching a new cache
+// line or page on every level as the classic array layout does once the
+// heap outgrows the cache. Keys live inline next to the node pointer, so
+// comparisons never dereference a node.
+//
+// Addressing, with B = 2^H and pos = block * B + local (local in [1, B)):
+//   inside a block      children of local i are 2i, 2i + 1 (as usual)
+//   block leaves        local i >= B/2 has children in blocks
+//                       block * B + 2 (i - B/2) + 1 (+1), each at local 1
+// Every child sits at a higher slot than its parent, so, as in Kamp's
+// B-heap, elements fill the slots in order (block by block) and the last
+// slot in use is always a leaf. The array stays dense (one unused slot per
+// block) at the price of a tree up to H levels deeper than a BFS-complete
+// one.
+//
+template <int H>
+class BHeapT : public PriorityQueue {
+    static_assert(H >= 2 && H <= 10, "block height out of range");
+
+public:
+    static constexpr uint32_t B = 1u << H;
+
+    BHeapT() : n(0) {}
+    ~BHeapT() override = default;
+
+    PQNodeBase* insert(double key, int value) override {
+        uint32_t p = slotOf(n);
+        ensureSlot(p);
+        BHeapNode* node = pool.create(value, p);
+        slots[p] = {key, node};
+        ++n;
+        siftUp(p);
+        return node;
+    }
+
+    // Floyd's heapify over the blocked layout: fill the new slots, then
+    // sift down every slot from the last one back to the root (children
+    // always sit at higher slots). Small batches are sifted up instead.
+    void bulk_insert(const std::pair<double,int>* items, size_t count,
+                     PQNodeBase** handles) override {
+        if (count == 0) return;
+        uint32_t old = n;
+        ensureSlot(slotOf(n + (uint32_t)count - 1));
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t p = slotOf(n++);
+            BHeapNode* node = pool.create(items[i].second, p);
+            slots[p] = {items[i].first, node};
+            if (handles) handles[i] = node;
+        }
+        if (count >= old) {
+            for (uint32_t p = slotOf(n - 1); p >= Root; --p) {
+                if (p % B != 0) siftDown(p);
+            }
+        } else {
+            for (uint32_t k = old; k < n; ++k)
+                siftUp(slotOf(k));
+        }
+    }
+
+    bool empty() const override {
+        return n == 0;
+    }
+
+    std::pair<double,int> find_min() const override {
+        if (n == 0) return {std::numeric_limits<double>::infinity(), -1};
+        return {slots[Root].key, slots[Root].node->value};
+    }
+
+    std::pair<double,int> extract_min() override {
+        if (n == 0) {
+            return {std::numeric_limits<double>::infinity(), -1};
+        }
+        Slot top = slots[Root];
+        top.node->inHeap = false;
+        --n;
+        uint32_t last = slotOf(n);
+        Slot moved = slots[last];
+        slots[last] = emptySlot();
+        if (last != Root) {
+            slots[Root] = moved;
+            siftDown(Root);
+        }
+        return {top.key, top.node->value};
+    }
+
+    void decrease_key(PQNodeBase* nb, double new_key) override {
+        auto* node = dynamic_cast<BHeapNode*>(nb);
+        if (!node || !node->inHeap) return;
+        if (new_key >= slots[node->pos].key) return;
+        slots[node->pos].key = new_key;
+        siftUp(node->pos);
+    }
+
+    void remove(PQNodeBase* nb) override {
+        auto* node = dynamic_cast<BHeapNode*>(nb);
+        if (!node || !node->inHeap) return;
+        decrease_key(node, -std::numeric_limits<double>::infinity());
+        extract_min();
+    }
+
+    int getSize() const override {
+        return (int)n;
+    }
+
+    int getHeightEstimate() const override {
+        if (n == 0) return 0;
+        return (int)std::floor(std::log2((double)n)) + 1;
+    }
+
+    int getNumTrees() const override {
+        return n == 0 ? 0 : 1;
+    }
+
+    long long getNumCascadingCuts() const override {
+        return 0;
+    }
+
+    double getMemoryUsageMBEstimate() const override {
+        double bytes = sizeof(*this) + slots.capacity() * sizeof(Slot) + pool.bytesReserved();
+        return bytes / (1024.0 * 1024.0);
+    }
+
+private:
+    struct Slot {
+        double key;
+        BHeapNode* node;
+    };
+
+    static constexpr uint32_t Root = 1; // block 0, local 1
+
+    TrackedVector<Slot, MemComponent::HeapStructure> slots;
+    NodePool<BHeapNode> pool;
+    uint32_t n;
+
+    static Slot emptySlot() {
+        return {std::numeric_limits<double>::infinity(), nullptr};
+    }
+
+    void ensureSlot(uint32_t p) {
+        if (p >= slots.size()) {
+            size_t want = std::max<size_t>((size_t)p + 1, slots.size() * 2);
+            want = (want + B - 1) / B * B;
+            slots.resize(want, emptySlot());
+        }
+    }
+
+    // Physical slot of the k-th element (0-based): slot 0 of each block is
+    // skipped.
+    static uint32_t slotOf(uint32_t k) {
+        return k + k / (B - 1) + 1;
+    }
+
+    static uint32_t parentOf(uint32_t p) {
+        uint32_t block = p / B;
+        uint32_t local = p % B;
+        if (local > 1) return block * B + local / 2;
+        uint32_t g = (block - 1) % B;
+        uint32_t parentBlock = (block - 1) / B;
+        return parentBlock * B + B / 2 + g / 2;
+    }
+
+    // First child; the second is firstChild + 1 inside a block and the
+    // first slot of the next block for block leaves.
+    static void childrenOf(uint32_t p, uint32_t& c1, uint32_t& c2) {
+        uint32_t block = p / B;
+        uint32_t local = p % B;
+        if (local < B / 2) {
+            c1 = p + local;          // block * B + 2 * local
+            c2 = c1 + 1;
+        } else {
+            uint32_t childBlock = block * B + 2 * (local - B / 2) + 1;
+            c1 = childBlock * B + 1;
+            c2 = c1 + B;
+        }
+    }
+
+    void siftUp(uint32_t p) {
+        Slot e = slots[p];
+        while (p != Root) {
+            uint32_t q = parentOf(p);
+            if (!(e.key < slots[q].key)) break;
+            slots[p] = slots[q];
+            slots[p].node->pos = p;
+            p = q;
+        }
+        slots[p] = e;
+        e.node->pos = p;
+    }
+
+    void siftDown(uint32_t p) {
+        Slot e = slots[p];
+        size_t size = slots.size();
+        while (true) {
+            uint32_t c1, c2;
+            childrenOf(p, c1, c2);
+            if (c1 >= size) break;
+            uint32_t best = c1;
+            if (c2 < size && slots[c2].key < slots[c1].key) best = c2;
+            if (!(slots[best].key < e.key)) break; // empty slots hold +inf
+            slots[p] = slots[best];
+            slots[p].node->pos = p;
+            p = best;
+        }
+        slots[p] = e;
+        e.node->pos = p;
+    }
+};
+
+using BHeap = BHeapT<8>;
+
+#endif // B_HEAP_H
@@ -0,0 +1,108 @@
+// batch_dijkstra.h
+#ifndef BATCH_DIJKSTRA_H
+#define BATCH_DIJKSTRA_H
+
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <algorithm>
+#include "graph.h"
+#include "priority_queue.h"
+#include "dijkstra.h"
+
+// One search answers every query of a batch. Forward (reverse == false):
+// the queries share the source root and the search follows neighbors().
+// Backward: they share the target root and the search follows
+// inNeighbors(), giving d(s, root) for each s in targets. Stops as soon as
+// every target is settled. dists[i] is the distance to targets[i], inf if
+// unreachable or out of range. Backward distances add the same edge weights
+// in the opposite order, so they can differ from a forward search in the
+// last bit. Afterwards ws.parent holds the search tree (predecessors
+// forward, next hops backward); see appendBatchPath.
+template <typename PQType>
+void runDijkstraBatch(
+    const Graph& g,
+    int root,
+    const std::vector<int>& targets,
+    bool reverse,
+    std::vector<double>& dists,
+    DijkstraMetrics& metrics,
+    DijkstraWorkspace& ws
+) {
+    const double inf = std::numeric_limits<double>::infinity();
+    int n = g.numVertices();
+    dists.assign(targets.size(), inf);
+
+    std::vector<int> wanted;
+    wanted.reserve(targets.size());
+    for (int t : targets) {
+        if (t >= 0 && t < n) wanted.push_back(t);
+    }
+    std::sort(wanted.begin(), wanted.end());
+    wanted.erase(std::unique(wanted.begin(), wanted.end()), wanted.end());
+    size_t remaining = wanted.size();
+
+    ws.prepare(n);
+    auto& dist = ws.dist;
+    auto& parent = ws.parent;
+    auto& handles = ws.handles;
+
+    PQType pq;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if (remaining > 0) {
+        dist[root] = 0.0;
+        ws.touch(root);
+        handles[root] = pq.insert(0.0, root);
+        metrics.inserts++;
+    }
+
+    while (!pq.empty()) {
+        auto [d, u] = pq.extract_min();
+        metrics.extractMins++;
+        if (d > dist[u]) continue;
+
+        if (std::binary_search(wanted.begin(), wanted.end(), u) && --remaining == 0) break;
+
+        const auto& edges = reverse ? g.inNeighbors(u) : g.neighbors(u);
+        for (const auto& e : edges) {
+            int v = e.to;
+            double nd = d + e.weight;
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                parent[v] = u;
+                if (handles[v] == nullptr) {
+                    ws.touch(v);
+                    handles[v] = pq.insert(nd, v);
+                    metrics.inserts++;
+                } else {
+                    pq.decrease_key(handles[v], nd);
+                    metrics.decreaseKeys++;
+                }
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    metrics.runtimeMs =
+        std::chrono::duration<double, std::milli>(end - start).count();
+
+    for (size_t i = 0; i < targets.size(); ++i) {
+        int t = targets[i];
+        if (t >= 0 && t < n) dists[i] = dist[t];
+    }
+}
+
+// Appends the path for one query of a finished runDijkstraBatch to path,
+// always ordered from the query's source to its target. other is the
+// query's non-shared endpoint; nothing is appended if it was not reached.
+inline void appendBatchPath(const DijkstraWorkspace& ws, int root, int other, bool reverse,
+                            std::vector<int>& path) {
+    if (ws.dist[other] == std::numeric_limits<double>::infinity()) return;
+    size_t first = path.size();
+    for (int v = other; v != -1; v = (v == root ? -1 : ws.parent[v])) path.push_back(v);
+    if (!reverse) std::reverse(path.begin() + first, path.end());
+}
+
+#endif // BATCH_DIJKSTRA_H
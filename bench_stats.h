@@ -0,0 +1,85 @@
+// bench_stats.h
+#ifndef BENCH_STATS_H
+#define BENCH_STATS_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+
+// Summary of repeated timing samples. Percentiles use linear interpolation
+// between closest ranks; the confidence interval is for the mean, using the
+// Student t distribution for small sample counts.
+struct SampleStats {
+    int count = 0;
+    double min = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+    double median = 0.0;
+    double stddev = 0.0;   // sample standard deviation (n - 1)
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double ci95Low = 0.0;
+    double ci95High = 0.0;
+};
+
+// Two-sided 95% critical values of Student's t: exact for 1..30 degrees of
+// freedom, beyond that interpolated linearly in 1/df between the table
+// values at 30, 40, 60, 120 and infinity (1.960).
+inline double tCritical95(int df) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    static const int tailDf[4] = {30, 40, 60, 120};
+    static const double tailT[4] = {2.042, 2.021, 2.000, 1.980};
+    if (df <= 0) return 0.0;
+    if (df <= 30) return table[df - 1];
+    double x = 1.0 / df;
+    for (int i = 1; i < 4; ++i) {
+        if (df <= tailDf[i]) {
+            double x0 = 1.0 / tailDf[i - 1], x1 = 1.0 / tailDf[i];
+            return tailT[i] + (tailT[i - 1] - tailT[i]) * (x - x1) / (x0 - x1);
+        }
+    }
+    return 1.960 + (tailT[3] - 1.960) * x * tailDf[3];
+}
+
+// p in [0, 1], samples must be sorted.
+inline double percentileSorted(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    double rank = p * (double)(sorted.size() - 1);
+    size_t lo = (size_t)std::floor(rank);
+    size_t hi = std::min(lo + 1, sorted.size() - 1);
+    double frac = rank - (double)lo;
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * frac;
+}
+
+inline SampleStats summarize(std::vector<double> samples) {
+    SampleStats s;
+    s.count = (int)samples.size();
+    if (samples.empty()) return s;
+
+    std::sort(samples.begin(), samples.end());
+    s.min = samples.front();
+    s.max = samples.back();
+    s.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / s.count;
+    s.median = percentileSorted(samples, 0.50);
+    s.p95 = percentileSorted(samples, 0.95);
+    s.p99 = percentileSorted(samples, 0.99);
+
+    if (s.count > 1) {
+        double sq = 0.0;
+        for (double x : samples) sq += (x - s.mean) * (x - s.mean);
+        s.stddev = std::sqrt(sq / (s.count - 1));
+        double half = tCritical95(s.count - 1) * s.stddev / std::sqrt((double)s.count);
+        s.ci95Low = s.mean - half;
+        s.ci95High = s.mean + half;
+    } else {
+        s.ci95Low = s.ci95High = s.mean;
+    }
+    return s;
+}
+
+#endif // BENCH_STATS_H
@@ -0,0 +1,555 @@
+// benchmark.cpp
+// Unified Dijkstra benchmark: one binary for every heap, graph and source set.
+//
+// Build: g++ -O2 -std=c++17 benchmark.cpp -o bench
+// Usage: ./bench --graph Hongkong.road-d [options]
+//        ./bench --gen grid:1000x1000 [options]
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <cstdio>
+#include <type_traits>
+#include <algorithm>
+
+#include "graph.h"
+#include "dijkstra.h"
+#include "heap_registry.h"
+#include "bench_stats.h"
+#include "dijkstra_perf.h"
+#include "latency_histogram.h"
+#include "graph_generators.h"
+#include "query_workload.h"
+#include "dijkstra_lazy.h"
+
+// Every heap the harness can run: indexed PriorityQueues, then lazy heaps.
+static std::vector<std::string> benchHeapNames() {
+    std::vector<std::string> names = allHeapNames();
+    for (const auto& h : allLazyHeapNames()) names.push_back(h);
+    return names;
+}
+
+struct BenchOptions {
+    std::string graphPath;
+    std::string genSpec;     // synthetic graph instead of a file, see graph_generators.h
+    bool directed = false;
+    std::vector<std::string> heaps = benchHeapNames();
+    std::vector<int> sources;
+    int randomSources = 0;
+    int spreadSources = 0;
+    std::string workloadPath; // use the distinct sources of a saved workload
+    unsigned int seed = 42;
+    int reps = 5;
+    int warmup = 1;
+    std::string format = "csv";
+    std::string outPath;
+    bool perf = false;       // one extra run per source with hardware counters
+    bool perfPerOp = false;  // ... broken down by heap operation class
+    std::string latencyPrefix; // per-operation latency histograms, if set
+};
+
+struct BenchRow {
+    std::string heap;
+    std::string source;  // vertex id, or "all" for the aggregate row
+    SampleStats runtime;
+    long long inserts = 0;
+    long long extractMins = 0;
+    long long decreaseKeys = 0;
+    double peakHeapMB = 0.0; // heap nodes + heap structure, last timed run
+    bool hasPerf = false;
+    DijkstraPerfReport perf;
+};
+
+static void printUsage() {
+    std::cerr <<
+        "Usage: ./bench --graph <file.road-d> [options]\n"
+        "       ./bench --gen <spec> [options]\n"
+        "  --gen SPEC               synthetic graph: grid:RxC, rgg:N:DEGREE,\n"
+        "                           rmat:SCALE:FACTOR (seeded by --seed)\n"
+        "  --directed               load edges as directed (default undirected)\n"
+        "  --heaps a,b,...          heaps to run (default: all registered heaps,\n"
+        "                           lazy2/lazy4/seq/seqdisk = lazy deletion,\n"
+        "                           no decrease-key)\n"
+        "  --sources v1,v2,...      explicit source vertices\n"
+        "  --random-sources N       N uniformly random sources (see --seed)\n"
+        "  --spread-sources N       N evenly spaced sources\n"
+        "  --workload FILE          sources of a workload from workload_gen\n"
+        "  --seed S                 RNG seed for --random-sources / --gen (default 42)\n"
+        "  --reps N                 timed repetitions per source (default 5)\n"
+        "  --warmup N               untimed runs per source first (default 1)\n"
+        "  --format csv|json        output format (default csv)\n"
+        "  --out FILE               write results to FILE instead of stdout\n"
+        "  --perf                   add hardware counters (Linux perf_event)\n"
+        "  --perf-per-op            also split counters by heap operation\n"
+        "  --latency PREFIX         per-operation latency histograms to\n"
+        "                           PREFIX_summary.csv and PREFIX_hist.csv\n";
+}
+
+static std::vector<std::string> splitList(const std::string& s) {
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) out.push_back(item);
+    }
+    return out;
+}
+
+static bool parseArgs(int argc, char** argv, BenchOptions& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        auto next = [&](std::string& val) {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: missing value for " << a << "\n";
+                return false;
+            }
+            val = argv[++i];
+            return true;
+        };
+        std::string val;
+        try {
+            if (a == "--graph") {
+                if (!next(opt.graphPath)) return false;
+            } else if (a == "--gen") {
+                if (!next(opt.genSpec)) return false;
+            } else if (a == "--directed") {
+                opt.directed = true;
+            } else if (a == "--heaps") {
+                if (!next(val)) return false;
+                opt.heaps = splitList(val);
+            } else if (a == "--sources") {
+                if (!next(val)) return false;
+                for (const auto& s : splitList(val)) opt.sources.push_back(std::stoi(s));
+            } else if (a == "--random-sources") {
+                if (!next(val)) return false;
+                opt.randomSources = std::stoi(val);
+            } else if (a == "--spread-sources") {
+                if (!next(val)) return false;
+                opt.spreadSources = std::stoi(val);
+            } else if (a == "--workload") {
+                if (!next(opt.workloadPath)) return false;
+            } else if (a == "--seed") {
+                if (!next(val)) return false;
+                opt.seed = (unsigned int)std::stoul(val);
+            } else if (a == "--reps") {
+                if (!next(val)) return false;
+                opt.reps = std::stoi(val);
+            } else if (a == "--warmup") {
+                if (!next(val)) return false;
+                opt.warmup = std::stoi(val);
+            } else if (a == "--format") {
+                if (!next(opt.format)) return false;
+            } else if (a == "--out") {
+                if (!next(opt.outPath)) return false;
+            } else if (a == "--perf") {
+                opt.perf = true;
+            } else if (a == "--perf-per-op") {
+                opt.perf = true;
+                opt.perfPerOp = true;
+            } else if (a == "--latency") {
+                if (!next(opt.latencyPrefix)) return false;
+            } else if (a == "--help" || a == "-h") {
+                return false;
+            } else {
+                std::cerr << "Error: unknown option " << a << "\n";
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Error: invalid value for " << a << "\n";
+            return false;
+        }
+    }
+    if (opt.graphPath.empty() == opt.genSpec.empty()) {
+        std::cerr << "Error: exactly one of --graph and --gen is required\n";
+        return false;
+    }
+    if (opt.format != "csv" && opt.format != "json") {
+        std::cerr << "Error: --format must be csv or json\n";
+        return false;
+    }
+    if (opt.reps < 1) opt.reps = 1;
+    if (opt.warmup < 0) opt.warmup = 0;
+    return true;
+}
+
+static const std::string& graphName(const BenchOptions& opt) {
+    return opt.graphPath.empty() ? opt.genSpec : opt.graphPath;
+}
+
+// JSON string body: quotes, backslashes and control characters escaped.
+static std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char ch : s) {
+        unsigned char c = (unsigned char)ch;
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += ch;
+        } else if (c < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += ch;
+        }
+    }
+    return out;
+}
+
+// CSV field, quoted (RFC 4180) if it holds a comma, quote or line break.
+static std::string csvField(const std::string& s) {
+    if (s.find_first_of(",\"\r\n") == std::string::npos) return s;
+    std::string out = "\"";
+    for (char ch : s) {
+        if (ch == '"') out += '"';
+        out += ch;
+    }
+    return out + "\"";
+}
+
+static std::vector<int> buildSources(const BenchOptions& opt, int n) {
+    std::vector<int> sources;
+    for (int s : opt.sources) {
+        if (s >= 0 && s < n) sources.push_back(s);
+        else std::cerr << "Warning: source " << s << " out of range, skipped\n";
+    }
+    if (opt.randomSources > 0) {
+        std::mt19937 rng(opt.seed);
+        std::uniform_int_distribution<int> pick(0, n - 1);
+        for (int i = 0; i < opt.randomSources; ++i) sources.push_back(pick(rng));
+    }
+    if (opt.spreadSources > 0) {
+        int step = std::max(1, n / opt.spreadSources);
+        int added = 0;
+        for (int s = 0; s < n && added < opt.spreadSources; s += step, ++added) {
+            sources.push_back(s);
+        }
+    }
+    if (sources.empty()) sources.push_back(0);
+    return sources;
+}
+
+struct HeapLatency {
+    std::string heap;
+    LatencyProfile profile;
+};
+
+// Bytes charged to the heap (nodes and structure), live or peak.
+static long long heapBytes(long long MemoryUsage::*field) {
+    return memoryUsage(MemComponent::HeapNodes).*field
+         + memoryUsage(MemComponent::HeapStructure).*field;
+}
+
+// Lazy heaps have their own Dijkstra and no decrease_key to instrument.
+template <typename PQType>
+void runBenchDijkstra(const Graph& g, int source, DijkstraMetrics& m) {
+    if constexpr (std::is_base_of<PriorityQueue, PQType>::value) {
+        runDijkstra<PQType>(g, source, m);
+    } else {
+        runDijkstraLazy<PQType>(g, source, m);
+    }
+}
+
+template <typename PQType>
+void benchHeap(const Graph& g, const std::string& heapName,
+               const std::vector<int>& sources, const BenchOptions& opt,
+               std::vector<BenchRow>& rows, std::vector<HeapLatency>& latencies) {
+    if (!opt.latencyPrefix.empty()) {
+        LatencyProfile::threadDefault().reset();
+    }
+
+    std::vector<double> allSamples;
+    BenchRow total;
+    total.heap = heapName;
+    total.source = "all";
+
+    for (int s : sources) {
+        for (int w = 0; w < opt.warmup; ++w) {
+            DijkstraMetrics m;
+            runBenchDijkstra<PQType>(g, s, m);
+        }
+
+        std::vector<double> samples;
+        DijkstraMetrics last;
+        long long heapBase = 0;
+        for (int r = 0; r < opt.reps; ++r) {
+            if (r + 1 == opt.reps) {
+                resetMemoryPeaks();
+                heapBase = heapBytes(&MemoryUsage::liveBytes);
+            }
+            DijkstraMetrics m;
+            runBenchDijkstra<PQType>(g, s, m);
+            samples.push_back(m.runtimeMs);
+            last = m;
+        }
+        double peakHeapMB = bytesToMB(heapBytes(&MemoryUsage::peakBytes) - heapBase);
+
+        BenchRow row;
+        row.heap = heapName;
+        row.source = std::to_string(s);
+        row.runtime = summarize(samples);
+        row.inserts = last.inserts;
+        row.extractMins = last.extractMins;
+        row.decreaseKeys = last.decreaseKeys;
+        row.peakHeapMB = peakHeapMB;
+        if (opt.perf) {
+            // separate run so the counters never perturb the timed samples
+            DijkstraMetrics m;
+            if constexpr (std::is_base_of<PriorityQueue, PQType>::value) {
+                runDijkstraPerf<PQType>(g, s, m, row.perf, opt.perfPerOp);
+            } else {
+                PerfCounterGroup group;
+                row.perf.available = group.available();
+                row.perf.error = group.error();
+                group.reset();
+                group.start();
+                runDijkstraLazy<PQType>(g, s, m);
+                group.stop();
+                row.perf.total = group.read();
+            }
+            row.hasPerf = true;
+            if (!row.perf.available) {
+                std::cerr << "Warning: " << row.perf.error << "\n";
+            }
+        }
+        rows.push_back(row);
+
+        if constexpr (std::is_base_of<PriorityQueue, PQType>::value) {
+            if (!opt.latencyPrefix.empty()) {
+                // untimed run; every heap call lands in the thread's profile
+                DijkstraMetrics m;
+                runDijkstra<InstrumentedPQ<PQType>>(g, s, m);
+            }
+        }
+
+        allSamples.insert(allSamples.end(), samples.begin(), samples.end());
+        total.inserts += last.inserts;
+        total.extractMins += last.extractMins;
+        total.decreaseKeys += last.decreaseKeys;
+        total.peakHeapMB = std::max(total.peakHeapMB, peakHeapMB);
+        if (row.hasPerf) {
+            total.hasPerf = true;
+            total.perf.available = row.perf.available;
+            total.perf.perOperation = row.perf.perOperation;
+            total.perf.total.add(row.perf.total);
+            total.perf.insert.add(row.perf.insert);
+            total.perf.extractMin.add(row.perf.extractMin);
+            total.perf.decreaseKey.add(row.perf.decreaseKey);
+        }
+
+        std::cerr << "  " << heapName << " source " << s
+                  << ": median " << row.runtime.median << " ms\n";
+    }
+
+    total.runtime = summarize(allSamples);
+    rows.push_back(total);
+
+    if (std::is_base_of<PriorityQueue, PQType>::value && !opt.latencyPrefix.empty()) {
+        latencies.push_back({heapName, LatencyProfile::threadDefault()});
+    }
+}
+
+static bool writeLatencyFiles(const std::string& prefix,
+                              const std::vector<HeapLatency>& latencies) {
+    std::ofstream summary(prefix + "_summary.csv");
+    std::ofstream hist(prefix + "_hist.csv");
+    if (!summary.is_open() || !hist.is_open()) {
+        std::cerr << "Error: could not open " << prefix << "_*.csv for writing.\n";
+        return false;
+    }
+    summary << "heap,op,count,mean_ns,p50_ns,p90_ns,p99_ns,p999_ns,p9999_ns,max_ns\n";
+    hist << "heap,op,bucket_low_ns,bucket_high_ns,count\n";
+    for (const auto& l : latencies) {
+        const std::pair<const char*, const LatencyHistogram*> ops[] = {
+            {"insert", &l.profile.insert},
+            {"extract_min", &l.profile.extractMin},
+            {"decrease_key", &l.profile.decreaseKey}};
+        for (const auto& op : ops) {
+            summary << l.heap << ",";
+            writeLatencySummaryRow(summary, op.first, *op.second);
+            std::ostringstream tmp;
+            writeLatencyDistribution(tmp, op.first, *op.second);
+            std::istringstream lines(tmp.str());
+            std::string line;
+            while (std::getline(lines, line)) hist << l.heap << "," << line << "\n";
+        }
+    }
+    std::cerr << "Latency histograms written to " << prefix << "_summary.csv and "
+              << prefix << "_hist.csv\n";
+    return true;
+}
+
+static void writeCsv(std::ostream& out, const BenchOptions& opt, const Graph& g,
+                     const std::vector<BenchRow>& rows) {
+    out << "graph,vertices,edges,heap,source,reps,median_ms,mean_ms,stddev_ms,"
+           "min_ms,max_ms,p95_ms,p99_ms,ci95_low_ms,ci95_high_ms,"
+           "inserts,extractMins,decreaseKeys,peak_heap_mb";
+    if (opt.perf) {
+        for (int i = 0; i < kNumPerfEvents; ++i) out << "," << perfEventName((PerfEvent)i);
+        out << ",ipc,perf_running";
+        if (opt.perfPerOp) {
+            out << ",insert_cycles,extract_min_cycles,decrease_key_cycles"
+                   ",insert_l1d_misses,extract_min_l1d_misses,decrease_key_l1d_misses";
+        }
+    }
+    out << "\n";
+    auto counter = [&](const PerfCounts& c, PerfEvent e) {
+        if (c.has(e)) out << c.get(e);
+        else out << "NA";
+    };
+    for (const auto& r : rows) {
+        const auto& t = r.runtime;
+        out << csvField(graphName(opt)) << "," << g.numVertices() << "," << g.numEdges() << ","
+            << r.heap << "," << r.source << "," << t.count << ","
+            << t.median << "," << t.mean << "," << t.stddev << ","
+            << t.min << "," << t.max << "," << t.p95 << "," << t.p99 << ","
+            << t.ci95Low << "," << t.ci95High << ","
+            << r.inserts << "," << r.extractMins << "," << r.decreaseKeys << ","
+            << r.peakHeapMB;
+        if (opt.perf) {
+            for (int i = 0; i < kNumPerfEvents; ++i) {
+                out << ",";
+                counter(r.perf.total, (PerfEvent)i);
+            }
+            out << "," << r.perf.total.ipc() << "," << r.perf.total.runningFraction();
+            if (opt.perfPerOp) {
+                for (PerfEvent e : {PerfEvent::Cycles, PerfEvent::L1DMisses}) {
+                    for (const PerfCounts* c : {&r.perf.insert, &r.perf.extractMin,
+                                                &r.perf.decreaseKey}) {
+                        out << ",";
+                        counter(*c, e);
+                    }
+                }
+            }
+        }
+        out << "\n";
+    }
+}
+
+static void writePerfJson(std::ostream& out, const PerfCounts& c) {
+    out << "{";
+    bool first = true;
+    for (int i = 0; i < kNumPerfEvents; ++i) {
+        if (!c.valid[i]) continue;
+        out << (first ? "" : ", ") << "\"" << perfEventName((PerfEvent)i) << "\": " << c.value[i];
+        first = false;
+    }
+    out << (first ? "" : ", ") << "\"ipc\": " << c.ipc()
+        << ", \"running\": " << c.runningFraction() << "}";
+}
+
+static void writeJson(std::ostream& out, const BenchOptions& opt, const Graph& g,
+                      const std::vector<BenchRow>& rows) {
+    out << "{\n";
+    out << "  \"graph\": \"" << jsonEscape(graphName(opt)) << "\",\n";
+    out << "  \"vertices\": " << g.numVertices() << ",\n";
+    out << "  \"edges\": " << g.numEdges() << ",\n";
+    out << "  \"reps\": " << opt.reps << ",\n";
+    out << "  \"warmup\": " << opt.warmup << ",\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const auto& r = rows[i];
+        const auto& t = r.runtime;
+        out << "    {\"heap\": \"" << jsonEscape(r.heap) << "\", \"source\": \"" << r.source << "\""
+            << ", \"samples\": " << t.count
+            << ", \"median_ms\": " << t.median << ", \"mean_ms\": " << t.mean
+            << ", \"stddev_ms\": " << t.stddev
+            << ", \"min_ms\": " << t.min << ", \"max_ms\": " << t.max
+            << ", \"p95_ms\": " << t.p95 << ", \"p99_ms\": " << t.p99
+            << ", \"ci95_ms\": [" << t.ci95Low << ", " << t.ci95High << "]"
+            << ", \"inserts\": " << r.inserts
+            << ", \"extractMins\": " << r.extractMins
+            << ", \"decreaseKeys\": " << r.decreaseKeys
+            << ", \"peak_heap_mb\": " << r.peakHeapMB;
+        if (r.hasPerf && r.perf.available) {
+            out << ", \"perf\": {\"total\": ";
+            writePerfJson(out, r.perf.total);
+            if (r.perf.perOperation) {
+                out << ", \"insert\": ";
+                writePerfJson(out, r.perf.insert);
+                out << ", \"extract_min\": ";
+                writePerfJson(out, r.perf.extractMin);
+                out << ", \"decrease_key\": ";
+                writePerfJson(out, r.perf.decreaseKey);
+            }
+            out << "}";
+        }
+        out << "}" << (i + 1 < rows.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage();
+        return 1;
+    }
+
+    for (const auto& h : opt.heaps) {
+        if (!withHeap(h, [](auto) {}) && !withLazyHeap(h, [](auto) {})) {
+            std::cerr << "Error: unknown heap '" << h << "'\n";
+            return 1;
+        }
+    }
+
+    Graph g;
+    if (!opt.genSpec.empty()) {
+        if (!generateGraphFromSpec(g, opt.genSpec, opt.seed, !opt.directed)) {
+            return 1;
+        }
+    } else if (!g.loadRoadD(opt.graphPath, !opt.directed)) {
+        return 1;
+    }
+    std::cerr << "Loaded graph: " << g.numVertices()
+              << " vertices, " << g.numEdges() << " edges\n";
+
+    if (!opt.workloadPath.empty()) {
+        QueryWorkload w;
+        if (!w.load(opt.workloadPath)) {
+            return 1;
+        }
+        if (!w.fits(g)) {
+            std::cerr << "Error: workload " << opt.workloadPath << " does not match this graph\n";
+            return 1;
+        }
+        for (int s : w.sources()) opt.sources.push_back(s);
+    }
+
+    std::vector<int> sources = buildSources(opt, g.numVertices());
+    std::cerr << "Sources: " << sources.size() << ", reps: " << opt.reps
+              << ", warmup: " << opt.warmup << "\n";
+
+    std::vector<BenchRow> rows;
+    std::vector<HeapLatency> latencies;
+    for (const auto& h : opt.heaps) {
+        auto run = [&](auto tag) {
+            using PQ = typename decltype(tag)::type;
+            benchHeap<PQ>(g, h, sources, opt, rows, latencies);
+        };
+        if (!withHeap(h, run)) withLazyHeap(h, run);
+    }
+    if (!opt.latencyPrefix.empty() && !writeLatencyFiles(opt.latencyPrefix, latencies)) {
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!opt.outPath.empty()) {
+        file.open(opt.outPath);
+        if (!file.is_open()) {
+            std::cerr << "Error: could not open " << opt.outPath << " for writing.\n";
+            return 1;
+        }
+    }
+    std::ostream& out = opt.outPath.empty() ? std::cout : file;
+    out << std::setprecision(6);
+    if (opt.format == "json") writeJson(out, opt, g, rows);
+    else writeCsv(out, opt, g, rows);
+
+    if (!opt.outPath.empty()) {
+        std::cerr << "Results written to " << opt.outPath << "\n";
+    }
+    return 0;
+}
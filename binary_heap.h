@@ -21,7 +21,11 @@ public:
 class BinaryHeap : public PriorityQueue {
 public:
     BinaryHeap() = default;
-    ~BinaryHeap() override = default;
+    // Searches that stop early (a target settled, a radius reached) leave
+    // nodes queued; they are freed here.
+    ~BinaryHeap() override {
+        for (auto* node : heap) delete node;
+    }
 
     PQNodeBase* insert(double key, int value) override {
         auto* node = new BinaryHeapNode(key, value, (int)heap.size());
@@ -30,6 +34,28 @@ public:
         return node;
     }
 
+    // Appends the batch and restores heap order with Floyd's bottom-up
+    // heapify, O(size) instead of O(count log size), when the batch is at
+    // least as large as what is already queued; small batches are sifted up
+    // one by one.
+    void bulk_insert(const std::pair<double,int>* items, size_t count,
+                     PQNodeBase** handles) override {
+        size_t old = heap.size();
+        heap.reserve(old + count);
+        for (size_t i = 0; i < count; ++i) {
+            auto* node = new BinaryHeapNode(items[i].first, items[i].second, (int)heap.size());
+            heap.push_back(node);
+            if (handles) handles[i] = node;
+        }
+        if (count >= old) {
+            for (int i = (int)heap.size() / 2 - 1; i >= 0; --i)
+                siftDown(i);
+        } else {
+            for (size_t i = old; i < heap.size(); ++i)
+                siftUp((int)i);
+        }
+    }
+
     bool empty() const override {
         return heap.empty();
     }
@@ -114,7 +140,7 @@ public:
     }
 
 private:
-    std::vector<BinaryHeapNode*> heap;
+    TrackedVector<BinaryHeapNode*, MemComponent::HeapStructure> heap;
 
     void siftUp(int i) {
         while (i > 0) {
@@ -0,0 +1,134 @@
+// bounded_dijkstra.h
+#ifndef BOUNDED_DIJKSTRA_H
+#define BOUNDED_DIJKSTRA_H
+
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <algorithm>
+#include <utility>
+#include "graph.h"
+#include "priority_queue.h"
+#include "dijkstra.h"
+#include "shortest_path_tree.h"
+
+// Isochrone / service-area search: settles only vertices with
+// dist <= maxDist. Relaxations beyond the radius are never inserted, so the
+// queue stays as small as the ball itself and the search ends as soon as
+// its minimum would exceed the radius.
+template <typename PQType>
+ShortestPathTree<double> runDijkstraBounded(
+    const Graph& g,
+    int source,
+    double maxDist,
+    DijkstraMetrics& metrics,
+    DijkstraWorkspace& ws
+) {
+    ws.prepare(g.numVertices());
+    auto& dist = ws.dist;
+    auto& parent = ws.parent;
+    auto& handles = ws.handles;
+
+    ShortestPathTree<double> tree;
+    tree.source = source;
+    tree.numGraphVertices = g.numVertices();
+
+    PQType pq;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if (maxDist >= 0.0) {
+        dist[source] = 0.0;
+        ws.touch(source);
+        handles[source] = pq.insert(0.0, source);
+        metrics.inserts++;
+    }
+
+    while (!pq.empty()) {
+        if (pq.find_min().first > maxDist) break;
+        auto [d, u] = pq.extract_min();
+        metrics.extractMins++;
+        if (d > dist[u] || ws.settledIdx[u] >= 0) continue;
+
+        ws.settledIdx[u] = tree.size();
+        tree.vertices.push_back(u);
+        tree.parentIdx.push_back(parent[u] < 0 ? -1 : ws.settledIdx[parent[u]]);
+        tree.dist.push_back(d);
+
+        for (const auto& e : g.neighbors(u)) {
+            int v = e.to;
+            double nd = d + e.weight;
+            if (nd < dist[v] && nd <= maxDist) {
+                dist[v] = nd;
+                parent[v] = u;
+                if (handles[v] == nullptr) {
+                    ws.touch(v);
+                    handles[v] = pq.insert(nd, v);
+                    metrics.inserts++;
+                } else {
+                    pq.decrease_key(handles[v], nd);
+                    metrics.decreaseKeys++;
+                }
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    metrics.runtimeMs =
+        std::chrono::duration<double, std::milli>(end - start).count();
+
+    tree.buildLookup();
+    return tree;
+}
+
+template <typename PQType>
+ShortestPathTree<double> runDijkstraBounded(
+    const Graph& g, int source, double maxDist, DijkstraMetrics& metrics
+) {
+    DijkstraWorkspace ws;
+    return runDijkstraBounded<PQType>(g, source, maxDist, metrics, ws);
+}
+
+// Several radii in one pass. Settle order is non-decreasing in distance, so
+// ring i is simply tree.vertices[ringEnd[i-1] .. ringEnd[i]) (ringEnd[-1] = 0):
+// the vertices with radii[i-1] < dist <= radii[i].
+struct IsochroneRings {
+    ShortestPathTree<double> tree;
+    std::vector<double> radii;  // sorted ascending
+    std::vector<int> ringEnd;   // one past the last settle index of each ring
+
+    int ringBegin(int i) const { return i == 0 ? 0 : ringEnd[i - 1]; }
+};
+
+template <typename PQType>
+IsochroneRings runDijkstraMultiRadius(
+    const Graph& g,
+    int source,
+    std::vector<double> radii,
+    DijkstraMetrics& metrics,
+    DijkstraWorkspace& ws
+) {
+    IsochroneRings rings;
+    std::sort(radii.begin(), radii.end());
+    double maxDist = radii.empty() ? -1.0 : radii.back();
+    rings.tree = runDijkstraBounded<PQType>(g, source, maxDist, metrics, ws);
+    rings.radii = std::move(radii);
+
+    const auto& d = rings.tree.dist;
+    rings.ringEnd.reserve(rings.radii.size());
+    for (double r : rings.radii) {
+        rings.ringEnd.push_back(
+            (int)(std::upper_bound(d.begin(), d.end(), r) - d.begin()));
+    }
+    return rings;
+}
+
+template <typename PQType>
+IsochroneRings runDijkstraMultiRadius(
+    const Graph& g, int source, std::vector<double> radii, DijkstraMetrics& metrics
+) {
+    DijkstraWorkspace ws;
+    return runDijkstraMultiRadius<PQType>(g, source, std::move(radii), metrics, ws);
+}
+
+#endif // BOUNDED_DIJKSTRA_H
@@ -0,0 +1,152 @@
+// concurrent_sssp.h
+#ifndef CONCURRENT_SSSP_H
+#define CONCURRENT_SSSP_H
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <limits>
+#include <utility>
+#include "graph.h"
+#include "dijkstra.h"
+
+// Shared-frontier parallel SSSP driver. All threads work on one search and
+// take vertices from a concurrent, possibly relaxed, priority queue (the
+// Frontier); runDijkstraMultiQueue and runDijkstraSkipList plug in theirs.
+//
+// A Frontier provides
+//   struct Context;                       per-thread state (RNG, counters)
+//   Context makeContext(int tid);         called before the threads start
+//   void push(double key, int value, Context& ctx);
+//   bool tryPop(std::pair<double,int>& out, Context& ctx);
+//
+// Relaxations compare-and-swap on an atomic dist array, and only the thread
+// whose CAS lowers dist[v] pushes v. Pops may come out of order, so a vertex
+// can be expanded again after its distance improves (label-correcting);
+// entries above the current dist[u] are skipped as stale. parent[] is rebuilt
+// from the final distances, which avoids racing updates to it.
+
+struct ConcurrentSearchStats {
+    long long stalePops = 0;       // popped entries already beaten by dist[u]
+    long long distCasFailures = 0; // CAS retries on dist[]
+    long long emptyPolls = 0;      // pops that found nothing while work was pending
+};
+
+// metrics.inserts / extractMins are summed over threads (extractMins
+// includes stale pops); metrics.runtimeMs covers the search and the parent
+// rebuild. contexts receives each thread's frontier context for the
+// caller's counters.
+template <typename Frontier>
+DijkstraResult runConcurrentSSSP(const Graph& g, int source, int numThreads,
+                                 Frontier& frontier,
+                                 std::vector<typename Frontier::Context>& contexts,
+                                 DijkstraMetrics& metrics,
+                                 ConcurrentSearchStats& stats) {
+    if (numThreads <= 0) numThreads = 1;
+    int n = g.numVertices();
+    const double inf = std::numeric_limits<double>::infinity();
+
+    TrackedVector<std::atomic<double>, MemComponent::Dijkstra> adist(n);
+    for (auto& d : adist) d.store(inf, std::memory_order_relaxed);
+
+    contexts.clear();
+    contexts.reserve(numThreads);
+    for (int t = 0; t < numThreads; ++t) contexts.push_back(frontier.makeContext(t));
+
+    // Entries pushed but not yet fully processed. A thread decrements it
+    // only after pushing everything its pop produced, so 0 means done.
+    std::atomic<long long> pending{0};
+
+    struct alignas(64) ThreadCounters {
+        DijkstraMetrics m;
+        ConcurrentSearchStats st;
+    };
+    std::vector<ThreadCounters> counters(numThreads);
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    adist[source].store(0.0, std::memory_order_relaxed);
+    pending.store(1, std::memory_order_relaxed);
+    frontier.push(0.0, source, contexts[0]);
+    counters[0].m.inserts++;
+
+    auto worker = [&](int tid) {
+        auto& ctx = contexts[tid];
+        DijkstraMetrics& m = counters[tid].m;
+        ConcurrentSearchStats& st = counters[tid].st;
+        std::pair<double,int> top;
+        while (true) {
+            if (!frontier.tryPop(top, ctx)) {
+                if (pending.load(std::memory_order_acquire) == 0) break;
+                st.emptyPolls++;
+                std::this_thread::yield();
+                continue;
+            }
+            m.extractMins++;
+            auto [d, u] = top;
+            if (d > adist[u].load(std::memory_order_relaxed)) {
+                st.stalePops++;
+                pending.fetch_sub(1, std::memory_order_acq_rel);
+                continue;
+            }
+            for (const auto& e : g.neighbors(u)) {
+                int v = e.to;
+                double nd = d + e.weight;
+                double old = adist[v].load(std::memory_order_relaxed);
+                while (nd < old) {
+                    if (adist[v].compare_exchange_weak(old, nd, std::memory_order_relaxed)) {
+                        pending.fetch_add(1, std::memory_order_relaxed);
+                        frontier.push(nd, v, ctx);
+                        m.inserts++;
+                        break;
+                    }
+                    st.distCasFailures++;
+                }
+            }
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (int t = 0; t < numThreads; ++t) threads.emplace_back(worker, t);
+    for (auto& th : threads) th.join();
+
+    DijkstraBuffer<double> dist(n);
+    for (int v = 0; v < n; ++v) dist[v] = adist[v].load(std::memory_order_relaxed);
+
+    // parent[v] = any in-neighbour u with dist[u] + w == dist[v]; the
+    // winning relaxation computed exactly that sum.
+    DijkstraBuffer<int> parent(n, -1);
+    auto rebuild = [&](int tid) {
+        for (int v = tid; v < n; v += numThreads) {
+            if (v == source || dist[v] == inf) continue;
+            for (const auto& e : g.inNeighbors(v)) {
+                if (dist[e.to] + e.weight == dist[v]) {
+                    parent[v] = e.to;
+                    break;
+                }
+            }
+        }
+    };
+    threads.clear();
+    for (int t = 0; t < numThreads; ++t) threads.emplace_back(rebuild, t);
+    for (auto& th : threads) th.join();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    metrics.runtimeMs =
+        std::chrono::duration<double, std::milli>(end - start).count();
+
+    for (const auto& c : counters) {
+        metrics.inserts += c.m.inserts;
+        metrics.extractMins += c.m.extractMins;
+        stats.stalePops += c.st.stalePops;
+        stats.distCasFailures += c.st.distCasFailures;
+        stats.emptyPolls += c.st.emptyPolls;
+    }
+
+    return DijkstraResult{std::move(dist), std::move(parent)};
+}
+
+#endif // CONCURRENT_SSSP_H
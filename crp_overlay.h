@@ -0,0 +1,347 @@
+// crp_overlay.h
+#ifndef CRP_OVERLAY_H
+#define CRP_OVERLAY_H
+
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include "graph.h"
+#include "priority_queue.h"
+#include "dijkstra.h"
+#include "graph_partition.h"
+
+// Customizable Route Planning (Delling, Goldberg, Pajor & Werneck, 2011)
+// with one overlay level over a GraphPartition.
+//
+//   build       metric-independent: the boundary vertices of every cell,
+//               entries (reached by an edge from another cell) and exits
+//               (with an edge into another cell)
+//   customize   per cell, the |entries| x |exits| matrix of shortest
+//               distances that stay inside the cell, one cell-restricted
+//               Dijkstra per entry. Cells are independent, so customize()
+//               spreads them over threads; after weight changes only the
+//               cells returned by cellsAffectedBy() need customizeCells().
+//               Cut edges are read from the graph at query time, so
+//               changing one never needs customizing.
+//   query       Dijkstra over the source and target cells plus the overlay:
+//               inside those two cells it follows graph edges, elsewhere it
+//               goes entry -> exit through the matrices and exit -> entry
+//               over cut edges. Paths are unpacked with cell-restricted
+//               searches between the boundary vertices.
+//
+// The overlay reads the current weights of the Graph it was built on.
+// Adding or removing edges can change the cell boundaries; build a new
+// overlay after that (customize() and query() refuse once
+// Graph::structureVersion() has moved on).
+
+struct CRPCustomizeStats {
+    double runtimeMs = 0.0;
+    int cells = 0;              // cells customized
+    long long searches = 0;     // cell-restricted Dijkstra runs
+    long long extractMins = 0;
+};
+
+class CRPOverlay {
+public:
+    CRPOverlay(const Graph& graph, GraphPartition partition)
+        : g(graph), part(std::move(partition)), structureAtBuild(graph.structureVersion()) {
+        int n = g.numVertices();
+        entryRow.assign(n, -1);
+        exitCol.assign(n, -1);
+        cells.resize(part.numCells);
+        for (int u = 0; u < n; ++u) {
+            int cu = part.cellOf[u];
+            for (const auto& e : g.neighbors(u)) {
+                int cv = part.cellOf[e.to];
+                if (cv == cu) continue;
+                if (exitCol[u] < 0) {
+                    exitCol[u] = (int)cells[cu].exits.size();
+                    cells[cu].exits.push_back(u);
+                }
+                if (entryRow[e.to] < 0) {
+                    entryRow[e.to] = (int)cells[cv].entries.size();
+                    cells[cv].entries.push_back(e.to);
+                }
+            }
+        }
+        size_t offset = 0;
+        for (auto& c : cells) {
+            c.offset = offset;
+            offset += c.entries.size() * c.exits.size();
+        }
+        matrix.assign(offset, std::numeric_limits<double>::infinity());
+    }
+
+    const GraphPartition& partition() const { return part; }
+
+    int numBoundaryVertices() const {
+        int b = 0;
+        for (int v = 0; v < g.numVertices(); ++v) {
+            if (entryRow[v] >= 0 || exitCol[v] >= 0) ++b;
+        }
+        return b;
+    }
+
+    size_t matrixEntries() const { return matrix.size(); }
+    bool customized() const { return isCustomized; }
+
+    template <typename PQType>
+    bool customize(int numThreads = 1, CRPCustomizeStats* stats = nullptr) {
+        std::vector<int> all(part.numCells);
+        for (int c = 0; c < part.numCells; ++c) all[c] = c;
+        if (!customizeCells<PQType>(all, numThreads, stats)) return false;
+        isCustomized = true;
+        return true;
+    }
+
+    // Recomputes the matrices of the given cells from the current weights.
+    template <typename PQType>
+    bool customizeCells(const std::vector<int>& which, int numThreads = 1,
+                        CRPCustomizeStats* stats = nullptr) {
+        if (!matchesGraph()) return false;
+        if (numThreads <= 0) numThreads = 1;
+        std::atomic<size_t> next{0};
+        std::vector<CRPCustomizeStats> local(numThreads);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto worker = [&](int tid) {
+            DijkstraWorkspace ws;
+            DijkstraMetrics m;
+            while (true) {
+                size_t i = next.fetch_add(1);
+                if (i >= which.size()) break;
+                int c = which[i];
+                if (c < 0 || c >= part.numCells) continue;
+                const Cell& cell = cells[c];
+                for (size_t r = 0; r < cell.entries.size(); ++r) {
+                    cellSearch<PQType>(c, cell.entries[r], -1, ws, m);
+                    double* row = &matrix[cell.offset + r * cell.exits.size()];
+                    for (size_t j = 0; j < cell.exits.size(); ++j) row[j] = ws.dist[cell.exits[j]];
+                    local[tid].searches++;
+                }
+                local[tid].cells++;
+            }
+            local[tid].extractMins = m.extractMins;
+        };
+        if (numThreads == 1) {
+            worker(0);
+        } else {
+            std::vector<std::thread> threads;
+            for (int t = 0; t < numThreads; ++t) threads.emplace_back(worker, t);
+            for (auto& th : threads) th.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        if (stats) {
+            CRPCustomizeStats total;
+            total.runtimeMs = std::chrono::duration<double, std::milli>(end - start).count();
+            for (const auto& l : local) {
+                total.cells += l.cells;
+                total.searches += l.searches;
+                total.extractMins += l.extractMins;
+            }
+            *stats = total;
+        }
+        return true;
+    }
+
+    // Cells whose matrices depend on the weight of edge u -> v: its own cell
+    // for an inner edge, none for a cut edge.
+    std::vector<int> cellsAffectedBy(int u, int v) const {
+        std::vector<int> out;
+        int n = g.numVertices();
+        if (u >= 0 && u < n && v >= 0 && v < n && part.cellOf[u] == part.cellOf[v]) {
+            out.push_back(part.cellOf[u]);
+        }
+        return out;
+    }
+
+    // Distance from s to t, inf if unreachable. If path is given it receives
+    // the full vertex path s .. t (empty if unreachable).
+    template <typename PQType>
+    double query(int s, int t, DijkstraMetrics& metrics, DijkstraWorkspace& ws,
+                 std::vector<int>* path = nullptr) const {
+        const double inf = std::numeric_limits<double>::infinity();
+        int n = g.numVertices();
+        if (path) path->clear();
+        if (s < 0 || s >= n || t < 0 || t >= n) {
+            std::cerr << "Error: query vertex out of range\n";
+            return inf;
+        }
+        if (!isCustomized) {
+            std::cerr << "Error: overlay queried before customize()\n";
+            return inf;
+        }
+        if (!matchesGraph()) return inf;
+
+        ws.prepare(n);
+        auto& dist = ws.dist;
+        auto& parent = ws.parent;
+        auto& handles = ws.handles;
+        int cs = part.cellOf[s], ct = part.cellOf[t];
+
+        PQType pq;
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        auto relax = [&](int u, int v, double nd) {
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                parent[v] = u;
+                if (handles[v] == nullptr) {
+                    ws.touch(v);
+                    handles[v] = pq.insert(nd, v);
+                    metrics.inserts++;
+                } else {
+                    pq.decrease_key(handles[v], nd);
+                    metrics.decreaseKeys++;
+                }
+            }
+        };
+
+        dist[s] = 0.0;
+        ws.touch(s);
+        handles[s] = pq.insert(0.0, s);
+        metrics.inserts++;
+
+        while (!pq.empty()) {
+            auto [d, u] = pq.extract_min();
+            metrics.extractMins++;
+            if (d > dist[u]) continue;
+            if (u == t) break;
+
+            int cu = part.cellOf[u];
+            if (cu == cs || cu == ct) {
+                for (const auto& e : g.neighbors(u)) relax(u, e.to, d + e.weight);
+                continue;
+            }
+            if (entryRow[u] >= 0) {
+                const Cell& cell = cells[cu];
+                const double* row = &matrix[cell.offset + (size_t)entryRow[u] * cell.exits.size()];
+                for (size_t j = 0; j < cell.exits.size(); ++j) {
+                    if (row[j] != inf) relax(u, cell.exits[j], d + row[j]);
+                }
+            }
+            if (exitCol[u] >= 0) {
+                for (const auto& e : g.neighbors(u)) {
+                    if (part.cellOf[e.to] != cu) relax(u, e.to, d + e.weight);
+                }
+            }
+        }
+
+        double result = dist[t];
+        if (path && result != inf) unpackPath<PQType>(s, t, ws, *path);
+
+        auto end = std::chrono::high_resolution_clock::now();
+        metrics.runtimeMs =
+            std::chrono::duration<double, std::milli>(end - start).count();
+        return result;
+    }
+
+    template <typename PQType>
+    double query(int s, int t, DijkstraMetrics& metrics, std::vector<int>* path = nullptr) const {
+        DijkstraWorkspace ws;
+        return query<PQType>(s, t, metrics, ws, path);
+    }
+
+private:
+    struct Cell {
+        std::vector<int> entries;
+        std::vector<int> exits;
+        size_t offset = 0; // first matrix entry, row-major by entry
+    };
+
+    const Graph& g;
+    GraphPartition part;
+    unsigned long long structureAtBuild;
+    std::vector<Cell> cells;
+    std::vector<int> entryRow; // row in its cell's matrix, -1 if not an entry
+    std::vector<int> exitCol;  // column in its cell's matrix, -1 if not an exit
+    TrackedVector<double, MemComponent::Graph> matrix;
+    bool isCustomized = false;
+
+    bool matchesGraph() const {
+        if (g.structureVersion() == structureAtBuild) return true;
+        std::cerr << "Error: graph edges were added or removed since the overlay "
+                  << "was built; build a new one\n";
+        return false;
+    }
+
+    // Dijkstra from source that never leaves cell. Stops when stopAt is
+    // settled, or with stopAt == -1 when every exit of the cell is.
+    template <typename PQType>
+    void cellSearch(int cell, int source, int stopAt, DijkstraWorkspace& ws,
+                    DijkstraMetrics& metrics) const {
+        ws.prepare(g.numVertices());
+        auto& dist = ws.dist;
+        auto& parent = ws.parent;
+        auto& handles = ws.handles;
+        size_t exitsLeft = cells[cell].exits.size();
+
+        PQType pq;
+        dist[source] = 0.0;
+        ws.touch(source);
+        handles[source] = pq.insert(0.0, source);
+        metrics.inserts++;
+
+        while (!pq.empty()) {
+            auto [d, u] = pq.extract_min();
+            metrics.extractMins++;
+            if (d > dist[u]) continue;
+            if (u == stopAt) break;
+            if (stopAt < 0 && exitCol[u] >= 0 && --exitsLeft == 0) break;
+
+            for (const auto& e : g.neighbors(u)) {
+                int v = e.to;
+                if (part.cellOf[v] != cell) continue;
+                double nd = d + e.weight;
+                if (nd < dist[v]) {
+                    dist[v] = nd;
+                    parent[v] = u;
+                    if (handles[v] == nullptr) {
+                        ws.touch(v);
+                        handles[v] = pq.insert(nd, v);
+                        metrics.inserts++;
+                    } else {
+                        pq.decrease_key(handles[v], nd);
+                        metrics.decreaseKeys++;
+                    }
+                }
+            }
+        }
+    }
+
+    // Expands the overlay path to t left in ws by query(). Consecutive
+    // vertices of the same cell, outside the source and target cells, are a
+    // matrix entry and are replaced by a cell-restricted shortest path.
+    template <typename PQType>
+    void unpackPath(int s, int t, DijkstraWorkspace& ws, std::vector<int>& path) const {
+        std::vector<int> overlay;
+        for (int v = t; v != -1; v = (v == s ? -1 : ws.parent[v])) overlay.push_back(v);
+        std::reverse(overlay.begin(), overlay.end());
+
+        int cs = part.cellOf[s], ct = part.cellOf[t];
+        DijkstraMetrics m;
+        std::vector<int> segment;
+        path.push_back(overlay[0]);
+        for (size_t i = 1; i < overlay.size(); ++i) {
+            int a = overlay[i - 1], b = overlay[i];
+            int c = part.cellOf[a];
+            if (c != part.cellOf[b] || c == cs || c == ct) {
+                path.push_back(b);
+                continue;
+            }
+            cellSearch<PQType>(c, a, b, ws, m);
+            segment.clear();
+            for (int v = b; v != a; v = ws.parent[v]) segment.push_back(v);
+            path.insert(path.end(), segment.rbegin(), segment.rend());
+        }
+    }
+};
+
+#endif // CRP_OVERLAY_H
@@ -0,0 +1,190 @@
+// crp_query.cpp
+// Partition a graph, build and customize a CRP overlay, and compare overlay
+// queries with plain early-stopping Dijkstra. Optionally applies random
+// weight changes and re-customizes only the affected cells, as a live
+// traffic feed would.
+//
+// Build: g++ -O2 -std=c++17 -pthread crp_query.cpp -o crp_query
+// Usage:
+//   ./crp_query --graph Hongkong.road-d --cell-size 1024 --threads 4
+//   ./crp_query --gen grid:500x500 --workload grid_rank.qwl --updates 1000
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <thread>
+
+#include "graph.h"
+#include "graph_generators.h"
+#include "graph_partition.h"
+#include "crp_overlay.h"
+#include "batch_dijkstra.h"
+#include "query_workload.h"
+#include "binary_heap.h"
+
+static void printUsage() {
+    std::cerr <<
+        "Usage: ./crp_query (--graph FILE | --gen SPEC) [options]\n"
+        "  --directed               load / generate a directed graph\n"
+        "  --seed S                 seed for --gen, the partition and the queries (default 1)\n"
+        "  --cell-size U            maximum vertices per cell (default 1024)\n"
+        "  --threads T              customization threads (default: hardware threads)\n"
+        "  --workload FILE          queries to run (default: 1000 random pairs)\n"
+        "  --count N                number of random pairs without --workload\n"
+        "  --updates K              then scale K random edge weights by 1..3x and\n"
+        "                           re-customize the affected cells\n";
+}
+
+struct QueryTotals {
+    double crpMs = 0.0;
+    double dijkstraMs = 0.0;
+    long long crpPops = 0;
+    long long dijkstraPops = 0;
+    int mismatches = 0;
+};
+
+// Runs every query through the overlay and through runDijkstraBatch.
+static QueryTotals compareQueries(const Graph& g, const CRPOverlay& overlay,
+                                  const std::vector<Query>& qs) {
+    QueryTotals tot;
+    DijkstraWorkspace wsCrp, wsDij;
+    std::vector<double> ref;
+    for (const auto& q : qs) {
+        DijkstraMetrics mc, md;
+        double d = overlay.query<BinaryHeap>(q.source, q.target, mc, wsCrp);
+        runDijkstraBatch<BinaryHeap>(g, q.source, {q.target}, false, ref, md, wsDij);
+        tot.crpMs += mc.runtimeMs;
+        tot.dijkstraMs += md.runtimeMs;
+        tot.crpPops += mc.extractMins;
+        tot.dijkstraPops += md.extractMins;
+        // the overlay adds precomputed sums, so allow rounding differences
+        bool same = std::isinf(ref[0]) ? std::isinf(d)
+                                       : std::fabs(d - ref[0]) <= 1e-9 * std::max(1.0, ref[0]);
+        if (!same) {
+            if (tot.mismatches < 5) {
+                std::cerr << "Mismatch: " << q.source << " -> " << q.target << ": overlay "
+                          << d << ", Dijkstra " << ref[0] << "\n";
+            }
+            tot.mismatches++;
+        }
+    }
+    return tot;
+}
+
+static void printTotals(const char* label, const QueryTotals& t, size_t count) {
+    double n = count ? (double)count : 1.0;
+    std::cout << label << ": overlay " << t.crpMs / n << " ms, " << t.crpPops / n
+              << " pops per query; Dijkstra " << t.dijkstraMs / n << " ms, "
+              << t.dijkstraPops / n << " pops; speedup "
+              << (t.crpMs > 0 ? t.dijkstraMs / t.crpMs : 0.0) << "x; "
+              << t.mismatches << " mismatches\n";
+}
+
+int main(int argc, char** argv) {
+    std::string graphPath, genSpec, workloadPath;
+    bool directed = false;
+    unsigned long long seed = 1;
+    int cellSize = 1024, count = 1000, updates = 0;
+    int threads = (int)std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        try {
+            if (a == "--graph" && hasValue) graphPath = argv[++i];
+            else if (a == "--gen" && hasValue) genSpec = argv[++i];
+            else if (a == "--seed" && hasValue) seed = std::stoull(argv[++i]);
+            else if (a == "--cell-size" && hasValue) cellSize = std::stoi(argv[++i]);
+            else if (a == "--threads" && hasValue) threads = std::stoi(argv[++i]);
+            else if (a == "--workload" && hasValue) workloadPath = argv[++i];
+            else if (a == "--count" && hasValue) count = std::stoi(argv[++i]);
+            else if (a == "--updates" && hasValue) updates = std::stoi(argv[++i]);
+            else if (a == "--directed") directed = true;
+            else {
+                std::cerr << "Error: unknown or incomplete option " << a << "\n";
+                printUsage();
+                return 1;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Error: invalid value for " << a << "\n";
+            return 1;
+        }
+    }
+    if (graphPath.empty() == genSpec.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    Graph g;
+    if (!genSpec.empty()) {
+        if (!generateGraphFromSpec(g, genSpec, seed, !directed)) return 1;
+    } else if (!g.loadRoadD(graphPath, !directed)) {
+        return 1;
+    }
+    std::cout << "Graph: " << g.numVertices() << " vertices, " << g.numEdges() << " edges\n";
+
+    QueryWorkload w;
+    if (!workloadPath.empty()) {
+        if (!w.load(workloadPath) || !w.fits(g)) {
+            std::cerr << "Could not use workload " << workloadPath << "\n";
+            return 1;
+        }
+    } else {
+        w = generateRandomPairs(g, count, seed);
+    }
+
+    PartitionOptions po;
+    po.maxCellSize = cellSize;
+    po.seed = seed;
+    auto t1 = std::chrono::high_resolution_clock::now();
+    GraphPartition part = partitionGraph(g, po);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::vector<int> sizes = part.cellSizes();
+    std::cout << "Partition: " << part.numCells << " cells ("
+              << *std::min_element(sizes.begin(), sizes.end()) << ".."
+              << *std::max_element(sizes.begin(), sizes.end()) << " vertices), "
+              << part.cutEdges << " cut edges, "
+              << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms\n";
+
+    CRPOverlay overlay(g, part);
+    CRPCustomizeStats cs;
+    if (!overlay.customize<BinaryHeap>(threads, &cs)) return 1;
+    std::cout << "Overlay: " << overlay.numBoundaryVertices() << " boundary vertices, "
+              << overlay.matrixEntries() << " matrix entries\n";
+    std::cout << "Customization: " << cs.runtimeMs << " ms on " << threads << " threads ("
+              << cs.searches << " cell searches)\n";
+
+    QueryTotals before = compareQueries(g, overlay, w.queries);
+    printTotals("Queries", before, w.size());
+    int mismatches = before.mismatches;
+
+    if (updates > 0) {
+        SplitMix64 rng(seed + 1);
+        std::vector<int> dirty;
+        int applied = 0;
+        for (int i = 0; i < updates; ++i) {
+            int u = (int)rng.below(g.numVertices());
+            if (g.neighbors(u).empty()) continue;
+            const Edge& e = g.neighbors(u)[rng.below(g.neighbors(u).size())];
+            int v = e.to;
+            double w2 = e.weight * (1.0 + 2.0 * rng.uniform());
+            if (!g.updateEdgeWeight(u, v, w2)) continue;
+            ++applied;
+            for (int c : overlay.cellsAffectedBy(u, v)) dirty.push_back(c);
+            if (g.isUndirected()) {
+                for (int c : overlay.cellsAffectedBy(v, u)) dirty.push_back(c);
+            }
+        }
+        std::sort(dirty.begin(), dirty.end());
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+        if (!overlay.customizeCells<BinaryHeap>(dirty, threads, &cs)) return 1;
+        std::cout << "Updates: " << applied << " edge weights changed, " << cs.cells
+                  << " cells re-customized in " << cs.runtimeMs << " ms\n";
+        QueryTotals after = compareQueries(g, overlay, w.queries);
+        printTotals("Queries after updates", after, w.size());
+        mismatches += after.mismatches;
+    }
+    return mismatches ? 1 : 0;
+}
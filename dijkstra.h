@@ -5,12 +5,19 @@
 #include <vector>
 #include <limits>
 #include <chrono>
+#include <utility>
+#include <iostream>
 #include "graph.h"
 #include "priority_queue.h"
+#include "memory_tracker.h"
+
+// Per-vertex search buffers, charged to MemComponent::Dijkstra.
+template <typename T>
+using DijkstraBuffer = TrackedVector<T, MemComponent::Dijkstra>;
 
 struct DijkstraResult {
-    std::vector<double> dist;
-    std::vector<int> parent;
+    DijkstraBuffer<double> dist;
+    DijkstraBuffer<int> parent;
 };
 
 struct DijkstraMetrics {
@@ -20,21 +27,47 @@ struct DijkstraMetrics {
     double runtimeMs = 0.0;
 };
 
-template <typename PQType>
-DijkstraResult runDijkstra(const Graph& g, int source, DijkstraMetrics& metrics) {
-    int n = g.numVertices();
-    std::vector<double> dist(n, std::numeric_limits<double>::infinity());
-    std::vector<int> parent(n, -1);
-    std::vector<PQNodeBase*> handles(n, nullptr);
+// Reusable per-thread buffers for repeated queries. Only the entries written
+// by the previous query are reset, so a query that settles k vertices costs
+// O(k) to clean up instead of O(n) to reallocate.
+struct DijkstraWorkspace {
+    DijkstraBuffer<double> dist;
+    DijkstraBuffer<int> parent;
+    DijkstraBuffer<PQNodeBase*> handles;
+    DijkstraBuffer<int> settledIdx; // position in settle order, -1 if not settled
+    DijkstraBuffer<int> touched;
 
-    PQType pq;
-
-    auto start = std::chrono::high_resolution_clock::now();
+    void prepare(int n) {
+        if ((int)dist.size() != n) {
+            dist.assign(n, std::numeric_limits<double>::infinity());
+            parent.assign(n, -1);
+            handles.assign(n, nullptr);
+            settledIdx.assign(n, -1);
+            touched.clear();
+            return;
+        }
+        for (int v : touched) {
+            dist[v] = std::numeric_limits<double>::infinity();
+            parent[v] = -1;
+            handles[v] = nullptr;
+            settledIdx[v] = -1;
+        }
+        touched.clear();
+    }
 
-    dist[source] = 0.0;
-    handles[source] = pq.insert(0.0, source);
-    metrics.inserts++;
+    // Call right before inserting v into the queue; records the first write
+    // to v so prepare() can undo it.
+    void touch(int v) {
+        if (handles[v] == nullptr) touched.push_back(v);
+    }
+};
 
+// Main loop shared by the single-source and multi-seed drivers: settles
+// vertices until the queue runs dry.
+template <typename PQType>
+void dijkstraSettleAll(const Graph& g, PQType& pq,
+                       DijkstraBuffer<double>& dist, DijkstraBuffer<int>& parent,
+                       DijkstraBuffer<PQNodeBase*>& handles, DijkstraMetrics& metrics) {
     while (!pq.empty()) {
         auto [d, u] = pq.extract_min();
         metrics.extractMins++;
@@ -57,12 +90,81 @@ DijkstraResult runDijkstra(const Graph& g, int source, DijkstraMetrics& metrics)
             }
         }
     }
+}
+
+template <typename PQType>
+DijkstraResult runDijkstra(const Graph& g, int source, DijkstraMetrics& metrics) {
+    int n = g.numVertices();
+    DijkstraBuffer<double> dist(n, std::numeric_limits<double>::infinity());
+    DijkstraBuffer<int> parent(n, -1);
+    DijkstraBuffer<PQNodeBase*> handles(n, nullptr);
+
+    PQType pq;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    dist[source] = 0.0;
+    handles[source] = pq.insert(0.0, source);
+    metrics.inserts++;
+
+    dijkstraSettleAll(g, pq, dist, parent, handles, metrics);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    metrics.runtimeMs =
+        std::chrono::duration<double, std::milli>(end - start).count();
+
+    DijkstraResult res{std::move(dist), std::move(parent)};
+    return res;
+}
+
+// One search from many seeds (unlike runDijkstraMultiSource in
+// parallel_dijkstra.h, which runs independent searches): equivalent to a
+// search from a virtual super source with an edge of weight offset to every
+// seed (vertex, offset), as in nearest-depot queries or isochrones around a
+// region. dist[v] is the smallest offset + d(seed, v) and parent[] chains
+// end at a seed. All seeds enter the queue through one bulk_insert. A
+// vertex listed twice keeps its smaller offset; out-of-range seeds are
+// reported and skipped.
+template <typename PQType>
+DijkstraResult runDijkstraMultiSeed(const Graph& g,
+                                    const std::vector<std::pair<int,double>>& seeds,
+                                    DijkstraMetrics& metrics) {
+    int n = g.numVertices();
+    DijkstraBuffer<double> dist(n, std::numeric_limits<double>::infinity());
+    DijkstraBuffer<int> parent(n, -1);
+    DijkstraBuffer<PQNodeBase*> handles(n, nullptr);
+
+    PQType pq;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<int> order;
+    order.reserve(seeds.size());
+    for (const auto& [v, offset] : seeds) {
+        if (v < 0 || v >= n) {
+            std::cerr << "Error: seed vertex " << v << " out of range\n";
+            continue;
+        }
+        if (offset < dist[v]) {
+            if (dist[v] == std::numeric_limits<double>::infinity()) order.push_back(v);
+            dist[v] = offset;
+        }
+    }
+    std::vector<std::pair<double,int>> items;
+    items.reserve(order.size());
+    for (int v : order) items.emplace_back(dist[v], v);
+    std::vector<PQNodeBase*> seedHandles(items.size(), nullptr);
+    pq.bulk_insert(items.data(), items.size(), seedHandles.data());
+    for (size_t i = 0; i < order.size(); ++i) handles[order[i]] = seedHandles[i];
+    metrics.inserts += (long long)items.size();
+
+    dijkstraSettleAll(g, pq, dist, parent, handles, metrics);
 
     auto end = std::chrono::high_resolution_clock::now();
     metrics.runtimeMs =
         std::chrono::duration<double, std::milli>(end - start).count();
 
-    DijkstraResult res{dist, parent};
+    DijkstraResult res{std::move(dist), std::move(parent)};
     return res;
 }
 
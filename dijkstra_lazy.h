@@ -0,0 +1,68 @@
+// dijkstra_lazy.h
+#ifndef DIJKSTRA_LAZY_H
+#define DIJKSTRA_LAZY_H
+
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <utility>
+#include "graph.h"
+#include "dijkstra.h"
+#include "lazy_heap.h"
+
+// Dijkstra without decrease_key. An improved distance is pushed as a new
+// entry; older entries for the same vertex are recognised as stale when
+// popped (d > dist[u]) and skipped. No handle array is needed.
+//
+// metrics.inserts counts pushes (so inserts - settled vertices = duplicate
+// entries), metrics.extractMins counts pops including stale ones, and
+// metrics.decreaseKeys is always 0.
+//
+// The overload taking pq runs on a caller-configured heap (e.g. a
+// SequenceHeap with a memory budget); pq must be empty.
+template <typename HeapType>
+DijkstraResult runDijkstraLazy(const Graph& g, int source, DijkstraMetrics& metrics,
+                               HeapType& pq) {
+    int n = g.numVertices();
+    DijkstraBuffer<double> dist(n, std::numeric_limits<double>::infinity());
+    DijkstraBuffer<int> parent(n, -1);
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    dist[source] = 0.0;
+    pq.push(0.0, source);
+    metrics.inserts++;
+
+    while (!pq.empty()) {
+        auto top = pq.pop();
+        double d = top.key;
+        int u = top.value;
+        metrics.extractMins++;
+        if (d > dist[u]) continue;
+
+        for (const auto& e : g.neighbors(u)) {
+            int v = e.to;
+            double nd = d + e.weight;
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                parent[v] = u;
+                pq.push(nd, v);
+                metrics.inserts++;
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    metrics.runtimeMs =
+        std::chrono::duration<double, std::milli>(end - start).count();
+
+    return DijkstraResult{std::move(dist), std::move(parent)};
+}
+
+template <typename HeapType = LazyBinaryHeap>
+DijkstraResult runDijkstraLazy(const Graph& g, int source, DijkstraMetrics& metrics) {
+    HeapType pq;
+    return runDijkstraLazy(g, source, metrics, pq);
+}
+
+#endif // DIJKSTRA_LAZY_H
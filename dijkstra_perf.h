@@ -0,0 +1,120 @@
+// dijkstra_perf.h
+#ifndef DIJKSTRA_PERF_H
+#define DIJKSTRA_PERF_H
+
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <utility>
+#include "graph.h"
+#include "priority_queue.h"
+#include "dijkstra.h"
+#include "perf_counters.h"
+
+struct DijkstraPerfReport {
+    bool available = false;
+    std::string error;
+    PerfCounts total;        // whole run, relaxation loop included
+    bool perOperation = false;
+    PerfCounts insert;       // only inside pq.insert
+    PerfCounts extractMin;   // only inside pq.extract_min
+    PerfCounts decreaseKey;  // only inside pq.decrease_key
+};
+
+// runDijkstra with hardware counters. With perOperation = true the search
+// is run a second time with every heap call bracketed by its own counter
+// group, which tells whether e.g. extract_min is bound by cache misses or by
+// branch misses. The totals come from the first run only: enabling the
+// totals group together with a per-operation group (six events each) would
+// exceed the PMU and get both multiplexed. The second run costs two ioctls
+// per operation; metrics and runtimeMs are those of the first.
+template <typename PQType>
+DijkstraResult runDijkstraPerf(
+    const Graph& g,
+    int source,
+    DijkstraMetrics& metrics,
+    DijkstraPerfReport& report,
+    bool perOperation = false
+) {
+    int n = g.numVertices();
+    DijkstraBuffer<double> dist;
+    DijkstraBuffer<int> parent;
+    DijkstraBuffer<PQNodeBase*> handles;
+
+    PerfCounterGroup totalGroup;
+    report = DijkstraPerfReport{};
+    report.available = totalGroup.available();
+    report.error = totalGroup.error();
+    report.perOperation = perOperation && report.available;
+
+    PerfCounterGroup* insertGroup = nullptr;
+    PerfCounterGroup* extractGroup = nullptr;
+    PerfCounterGroup* decreaseGroup = nullptr;
+    auto bracket = [](PerfCounterGroup* grp, auto&& op) {
+        if (grp) grp->start();
+        op();
+        if (grp) grp->stop();
+    };
+
+    auto search = [&](DijkstraMetrics& m) {
+        dist.assign(n, std::numeric_limits<double>::infinity());
+        parent.assign(n, -1);
+        handles.assign(n, nullptr);
+        PQType pq;
+
+        dist[source] = 0.0;
+        bracket(insertGroup, [&]() { handles[source] = pq.insert(0.0, source); });
+        m.inserts++;
+
+        while (!pq.empty()) {
+            std::pair<double, int> top;
+            bracket(extractGroup, [&]() { top = pq.extract_min(); });
+            auto [d, u] = top;
+            m.extractMins++;
+            if (d > dist[u]) continue;
+
+            for (const auto& e : g.neighbors(u)) {
+                int v = e.to;
+                double w = e.weight;
+                double nd = d + w;
+                if (nd < dist[v]) {
+                    dist[v] = nd;
+                    parent[v] = u;
+                    if (handles[v] == nullptr) {
+                        bracket(insertGroup, [&]() { handles[v] = pq.insert(nd, v); });
+                        m.inserts++;
+                    } else {
+                        bracket(decreaseGroup, [&]() { pq.decrease_key(handles[v], nd); });
+                        m.decreaseKeys++;
+                    }
+                }
+            }
+        }
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    totalGroup.reset();
+    totalGroup.start();
+    search(metrics);
+    totalGroup.stop();
+    auto end = std::chrono::high_resolution_clock::now();
+    metrics.runtimeMs =
+        std::chrono::duration<double, std::milli>(end - start).count();
+    report.total = totalGroup.read();
+
+    if (report.perOperation) {
+        PerfCounterGroup ins, ext, dec;
+        insertGroup = &ins;
+        extractGroup = &ext;
+        decreaseGroup = &dec;
+        DijkstraMetrics again;
+        search(again);
+        report.insert = ins.read();
+        report.extractMin = ext.read();
+        report.decreaseKey = dec.read();
+    }
+
+    return DijkstraResult{std::move(dist), std::move(parent)};
+}
+
+#endif // DIJKSTRA_PERF_H
@@ -0,0 +1,207 @@
+// dynamic_dijkstra.h
+#ifndef DYNAMIC_DIJKSTRA_H
+#define DYNAMIC_DIJKSTRA_H
+
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <utility>
+#include "graph.h"
+#include "priority_queue.h"
+#include "dijkstra.h"
+
+// Keeps a single-source shortest-path tree valid while edges of the graph
+// change (Ramalingam-Reps style repair). Instead of rerunning runDijkstra,
+// each update only touches the vertices whose distance actually changes:
+//  - weight decrease / insertion: Dijkstra restarted from the improved head
+//  - weight increase / deletion of a tree edge: the subtree below it is
+//    reset, seeded from its unaffected in-neighbours and re-settled
+template <typename PQType>
+class DynamicDijkstra {
+public:
+    DynamicDijkstra(Graph& graph, int src)
+        : g(graph), source(src), lastAffected(0) {
+        DijkstraMetrics m;
+        res = runDijkstra<PQType>(g, source, m);
+        initWorkspace();
+    }
+
+    // Adopt an already computed result (e.g. from runDijkstra on g).
+    DynamicDijkstra(Graph& graph, int src, DijkstraResult existing)
+        : g(graph), source(src), res(std::move(existing)), lastAffected(0) {
+        initWorkspace();
+    }
+
+    bool updateEdge(int u, int v, double w) {
+        double oldW;
+        if (!g.updateEdgeWeight(u, v, w, &oldW)) return false;
+        if (w == oldW) return true;
+        beginRepair();
+        repairChanged(u, v, w);
+        if (g.isUndirected()) repairChanged(v, u, w);
+        endRepair();
+        return true;
+    }
+
+    bool insertEdge(int u, int v, double w) {
+        if (!g.addEdge(u, v, w)) return false;
+        beginRepair();
+        repairDecrease(u, v, w);
+        if (g.isUndirected()) repairDecrease(v, u, w);
+        endRepair();
+        return true;
+    }
+
+    bool removeEdge(int u, int v) {
+        if (!g.removeEdge(u, v)) return false;
+        beginRepair();
+        repairIncrease(u, v);
+        if (g.isUndirected()) repairIncrease(v, u);
+        endRepair();
+        return true;
+    }
+
+    const DijkstraResult& result() const { return res; }
+    int getSource() const { return source; }
+
+    // Metrics of the most recent update only.
+    const DijkstraMetrics& lastMetrics() const { return metrics; }
+    int lastAffectedCount() const { return lastAffected; }
+
+private:
+    Graph& g;
+    int source;
+    DijkstraResult res;
+    DijkstraMetrics metrics;
+    int lastAffected;
+
+    // Workspace kept between updates; only touched entries are reset.
+    std::vector<PQNodeBase*> handles;
+    std::vector<char> affected;
+    std::vector<int> touched;
+    std::chrono::high_resolution_clock::time_point repairStart;
+
+    void initWorkspace() {
+        int n = g.numVertices();
+        handles.assign(n, nullptr);
+        affected.assign(n, 0);
+    }
+
+    void beginRepair() {
+        metrics = DijkstraMetrics{};
+        lastAffected = 0;
+        repairStart = std::chrono::high_resolution_clock::now();
+    }
+
+    void endRepair() {
+        auto end = std::chrono::high_resolution_clock::now();
+        metrics.runtimeMs =
+            std::chrono::duration<double, std::milli>(end - repairStart).count();
+    }
+
+    // Edge u->v now has weight w: either the tree edge into v got more
+    // expensive, or v may be reachable more cheaply through u.
+    void repairChanged(int u, int v, double w) {
+        if (res.parent[v] == u && res.dist[u] + w > res.dist[v]) {
+            repairIncrease(u, v);
+        } else {
+            repairDecrease(u, v, w);
+        }
+    }
+
+    // Edge u->v became cheaper (or was added) with weight w.
+    void repairDecrease(int u, int v, double w) {
+        double nd = res.dist[u] + w;
+        if (!(nd < res.dist[v])) return;
+
+        PQType pq;
+        res.dist[v] = nd;
+        res.parent[v] = u;
+        push(pq, v, nd);
+        settle(pq);
+    }
+
+    // Edge u->v became more expensive (or was removed). Nothing to do unless
+    // it carried the tree path to v.
+    void repairIncrease(int u, int v) {
+        if (res.parent[v] != u) return;
+
+        // 1. collect the tree subtree rooted at v
+        std::vector<int> sub;
+        sub.push_back(v);
+        affected[v] = 1;
+        for (size_t i = 0; i < sub.size(); ++i) {
+            int x = sub[i];
+            for (const auto& e : g.neighbors(x)) {
+                int y = e.to;
+                if (!affected[y] && res.parent[y] == x) {
+                    affected[y] = 1;
+                    sub.push_back(y);
+                }
+            }
+        }
+        lastAffected += (int)sub.size();
+
+        for (int x : sub) {
+            res.dist[x] = std::numeric_limits<double>::infinity();
+            res.parent[x] = -1;
+        }
+
+        // 2. best tentative distance through unaffected in-neighbours
+        PQType pq;
+        for (int x : sub) {
+            for (const auto& e : g.inNeighbors(x)) {
+                int p = e.to;
+                if (affected[p]) continue;
+                double nd = res.dist[p] + e.weight;
+                if (nd < res.dist[x]) {
+                    res.dist[x] = nd;
+                    res.parent[x] = p;
+                }
+            }
+        }
+        for (int x : sub) {
+            affected[x] = 0;
+            if (res.dist[x] < std::numeric_limits<double>::infinity()) {
+                push(pq, x, res.dist[x]);
+            }
+        }
+
+        // 3. re-settle the subtree
+        settle(pq);
+    }
+
+    void push(PQType& pq, int v, double d) {
+        if (handles[v] == nullptr) {
+            handles[v] = pq.insert(d, v);
+            touched.push_back(v);
+            metrics.inserts++;
+        } else {
+            pq.decrease_key(handles[v], d);
+            metrics.decreaseKeys++;
+        }
+    }
+
+    // Same relaxation loop as runDijkstra, restricted to whatever was seeded.
+    void settle(PQType& pq) {
+        while (!pq.empty()) {
+            auto [d, u] = pq.extract_min();
+            metrics.extractMins++;
+            if (d > res.dist[u]) continue;
+
+            for (const auto& e : g.neighbors(u)) {
+                int v = e.to;
+                double nd = d + e.weight;
+                if (nd < res.dist[v]) {
+                    res.dist[v] = nd;
+                    res.parent[v] = u;
+                    push(pq, v, nd);
+                }
+            }
+        }
+        for (int v : touched) handles[v] = nullptr;
+        touched.clear();
+    }
+};
+
+#endif // DYNAMIC_DIJKSTRA_H
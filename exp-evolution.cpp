@@ -1,12 +1,11 @@
-%%writefile experiment_evolution_fibonacci.cpp
 #include <iostream>
-#include <fstream>
 #include <vector>
 #include <string>
 
 #include "graph.h"
 #include "fibonacci_heap.h"
-#include "dijkstra_tracked.h"
+#include "DijkstraTracked.h"
+#include "heap_evolution_sampler.h"
 
 int main(int argc, char** argv) {
     if (argc < 2) {
@@ -34,31 +33,21 @@ int main(int argc, char** argv) {
     std::cout << "Loaded graph: " << g.numVertices()
               << " vertices, " << g.numEdges() << " edges\n";
 
-    std::ofstream out("heap_evolution_fibonacci.csv");
-    if (!out.is_open()) {
-        std::cerr << "Could not open heap_evolution_fibonacci.csv\n";
+    HeapEvolutionSampler sampler;
+    if (!sampler.open("heap_evolution_fibonacci.csv")) {
         return 1;
     }
 
-    out << "step,heapSize,heapHeight,numTrees,cascadingCuts,inserts,extractMins,decreaseKeys\n";
-
     DijkstraMetrics metrics;
 
-    auto callback = [&](const FibonacciHeap& pq, long long step, const DijkstraMetrics& m) {
-        out << step << ","
-            << pq.getSize() << ","
-            << pq.getHeightEstimate() << ","
-            << pq.getNumTrees() << ","
-            << pq.getNumCascadingCuts() << ","
-            << m.inserts << ","
-            << m.extractMins << ","
-            << m.decreaseKeys << "\n";
-    };
-
-    // sample every 1000 extract-min operations
-    runDijkstraTracked<FibonacciHeap>(g, 0, metrics, callback, 1000);
+    // sample every 1000 extract-min operations; the CSV is written by the
+    // sampler's own thread, outside the timed loop
+    runDijkstraTracked<FibonacciHeap>(g, 0, metrics, sampler, 1000);
 
-    out.close();
+    sampler.close();
+    if (sampler.dropped() > 0) {
+        std::cerr << "Warning: " << sampler.dropped() << " samples dropped\n";
+    }
     std::cout << "Heap evolution written to heap_evolution_fibonacci.csv\n";
     std::cout << "Total runtime (ms): " << metrics.runtimeMs << "\n";
     return 0;
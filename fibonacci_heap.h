@@ -33,17 +33,20 @@ public:
 class FibonacciHeap : public PriorityQueue {
 public:
     FibonacciHeap()
-        : minNode(nullptr), nNodes(0), cascadingCuts(0) {}
+        : minNode(nullptr), nNodes(0), nRoots(0), cascadingCuts(0) {}
 
     ~FibonacciHeap() override {
         if (minNode)
             freeList(minNode);
+        for (auto* z : extracted)
+            delete z;
     }
 
     PQNodeBase* insert(double key, int value) override {
         auto* x = new FibonacciNode(key, value);
         if (minNode == nullptr) {
             minNode = x;
+            nRoots = 1;
         } else {
             insertIntoRootList(x);
             if (x->key < minNode->key)
@@ -53,6 +56,43 @@ public:
         return x;
     }
 
+    // Links the batch into one ring and splices it into the root list in a
+    // single step; the minimum is updated once at the end.
+    void bulk_insert(const std::pair<double,int>* items, size_t count,
+                     PQNodeBase** handles) override {
+        if (count == 0) return;
+        FibonacciNode* first = nullptr;
+        FibonacciNode* last = nullptr;
+        FibonacciNode* batchMin = nullptr;
+        for (size_t i = 0; i < count; ++i) {
+            auto* x = new FibonacciNode(items[i].first, items[i].second);
+            if (handles) handles[i] = x;
+            if (!first) {
+                first = x;
+            } else {
+                last->right = x;
+                x->left = last;
+            }
+            last = x;
+            if (!batchMin || x->key < batchMin->key) batchMin = x;
+        }
+        first->left = last;
+        last->right = first;
+
+        if (minNode == nullptr) {
+            minNode = batchMin;
+        } else {
+            FibonacciNode* after = minNode->right;
+            minNode->right = first;
+            first->left = minNode;
+            last->right = after;
+            after->left = last;
+            if (batchMin->key < minNode->key) minNode = batchMin;
+        }
+        nNodes += count;
+        nRoots += (int)count;
+    }
+
     bool empty() const override {
         return minNode == nullptr;
     }
@@ -85,15 +125,19 @@ public:
         }
 
         removeFromList(z);
+        --nRoots;
         if (z == z->right) {
             minNode = nullptr;
+            nRoots = 0;
         } else {
             minNode = z->right;
             consolidate();
         }
         std::pair<double,int> res = {z->key, z->value};
         z->inHeap = false;
-       // delete z;  //commenting this to ensure 10000 runs for exp B
+        // Callers may still hold z as a handle and pass it to decrease_key,
+        // so it is only freed together with the heap.
+        extracted.push_back(z);
         --nNodes;
         return res;
     }
@@ -129,14 +173,7 @@ public:
     }
 
     int getNumTrees() const override {
-        if (!minNode) return 0;
-        int count = 0;
-        FibonacciNode* curr = minNode;
-        do {
-            ++count;
-            curr = curr->right;
-        } while (curr != minNode);
-        return count;
+        return nRoots;
     }
 
     long long getNumCascadingCuts() const override {
@@ -145,14 +182,17 @@ public:
 
     double getMemoryUsageMBEstimate() const override {
         double bytes = sizeof(FibonacciHeap);
-        bytes += nNodes * sizeof(FibonacciNode);
+        bytes += (nNodes + extracted.size()) * sizeof(FibonacciNode);
+        bytes += extracted.capacity() * sizeof(FibonacciNode*);
         return bytes / (1024.0 * 1024.0);
     }
 
 private:
     FibonacciNode* minNode;
     size_t nNodes;
+    int nRoots;  // kept up to date so getNumTrees() is O(1) for samplers
     long long cascadingCuts;
+    TrackedVector<FibonacciNode*, MemComponent::HeapStructure> extracted;
 
     void insertIntoRootList(FibonacciNode* x) {
         if (!minNode) {
@@ -166,6 +206,7 @@ private:
         }
         x->parent = nullptr;
         x->mark = false;
+        ++nRoots;
     }
 
     static void removeFromList(FibonacciNode* x) {
@@ -203,8 +244,10 @@ private:
         }
 
         minNode = nullptr;
+        nRoots = 0;
         for (FibonacciNode* a : A) {
             if (a) {
+                ++nRoots;
                 if (!minNode) {
                     a->left = a->right = a;
                     minNode = a;
@@ -8,15 +8,21 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <tuple>
+#include <cstdio>
+#include "memory_tracker.h"
 
 struct Edge {
     int to;
     double weight;
 };
 
+using EdgeList = TrackedVector<Edge, MemComponent::Graph>;
+
 class Graph {
 public:
-    Graph() : nVertices(0), nEdges(0) {}
+    Graph() : nVertices(0), nEdges(0), undirectedGraph(true), versionCounter(0),
+              structureCounter(0) {}
 
     bool loadRoadD(const std::string& path, bool undirected = true) {
         std::ifstream in(path);
@@ -25,7 +31,7 @@ public:
             return false;
         }
         std::string line;
-        std::vector<std::tuple<int,int,double>> edges;
+        TrackedVector<std::tuple<int,int,double>, MemComponent::Graph> edges;
         int maxVertex = -1;
         while (std::getline(in, line)) {
             if (line.empty()) continue;
@@ -49,7 +55,12 @@ public:
 
         nVertices = maxVertex + 1;
         adj.assign(nVertices, {});
+        radj.clear();
+        if (!undirected) radj.assign(nVertices, {});
+        undirectedGraph = undirected;
         nEdges = 0;
+        versionCounter++;
+        structureCounter++;
 
         for (auto& e : edges) {
             int u, v;
@@ -58,6 +69,8 @@ public:
             adj[u].push_back({v, w});
             if (undirected) {
                 adj[v].push_back({u, w});
+            } else {
+                radj[v].push_back({u, w});
             }
             nEdges++;
         }
@@ -65,17 +78,166 @@ public:
         return true;
     }
 
+    // Empty graph on n vertices, to be filled with addEdge (used by the
+    // synthetic generators, which never go through a file).
+    void reset(int n, bool undirected = true) {
+        nVertices = n;
+        adj.assign(n, {});
+        radj.clear();
+        if (!undirected) radj.assign(n, {});
+        undirectedGraph = undirected;
+        nEdges = 0;
+        versionCounter++;
+        structureCounter++;
+    }
+
+    // Writes "u v w" lines that loadRoadD reads back into the same graph
+    // (same undirected flag), with weights rounded to 6 decimals like the
+    // shipped datasets. Undirected edges are written once. The format has no
+    // vertex count, so isolated vertices above the largest used id are lost.
+    bool writeRoadD(const std::string& path, const std::string& comment = "") const {
+        std::ofstream out(path);
+        if (!out.is_open()) {
+            std::cerr << "Error: cannot open file " << path << std::endl;
+            return false;
+        }
+        if (!comment.empty()) out << "# " << comment << "\n";
+        out << "# this road network has " << nVertices << " vertices and "
+            << nEdges << " edges\n";
+        out << "# Line 1~" << nEdges << ":  u, v, Distance(u,v)\n";
+
+        std::string buf;
+        buf.reserve(1 << 20);
+        char line[64];
+        for (int u = 0; u < nVertices; ++u) {
+            bool skipSelfLoop = false;
+            for (const auto& e : adj[u]) {
+                if (undirectedGraph) {
+                    // each undirected edge is stored at both ends; write it
+                    // from the smaller endpoint, and self-loops every other time
+                    if (e.to < u) continue;
+                    if (e.to == u) {
+                        skipSelfLoop = !skipSelfLoop;
+                        if (!skipSelfLoop) continue;
+                    }
+                }
+                int len = std::snprintf(line, sizeof(line), "%d %d %.6f\n", u, e.to, e.weight);
+                buf.append(line, (size_t)len);
+            }
+            if (buf.size() >= (1 << 20)) {
+                out.write(buf.data(), (std::streamsize)buf.size());
+                buf.clear();
+            }
+        }
+        out.write(buf.data(), (std::streamsize)buf.size());
+        return (bool)out;
+    }
+
     int numVertices() const { return nVertices; }
     long long numEdges() const { return nEdges; }
 
-    const std::vector<Edge>& neighbors(int u) const {
+    bool isUndirected() const { return undirectedGraph; }
+
+    // Bumped on every load / edge update so derived data (caches, etc.)
+    // can tell that it is stale.
+    unsigned long long version() const { return versionCounter; }
+
+    // Bumped only when the edge set changes (load, reset, add, remove), not
+    // on weight updates, for data that depends on connectivity alone.
+    unsigned long long structureVersion() const { return structureCounter; }
+
+    const EdgeList& neighbors(int u) const {
         return adj[u];
     }
 
+    // Incoming edges of u (edge.to is the tail). For undirected loads this
+    // is the same list as neighbors(u); directed loads keep a reverse list.
+    const EdgeList& inNeighbors(int u) const {
+        return undirectedGraph ? adj[u] : radj[u];
+    }
+
+    // --- Dynamic updates ---
+    // All three operate on the first stored u->v edge (and its v->u mirror
+    // for undirected graphs). They return false if the edge / vertex does
+    // not exist, leaving the graph unchanged.
+
+    bool addEdge(int u, int v, double w) {
+        if (!validVertex(u) || !validVertex(v)) return false;
+        adj[u].push_back({v, w});
+        if (undirectedGraph) {
+            adj[v].push_back({u, w});
+        } else {
+            radj[v].push_back({u, w});
+        }
+        nEdges++;
+        versionCounter++;
+        structureCounter++;
+        return true;
+    }
+
+    bool updateEdgeWeight(int u, int v, double w, double* oldWeight = nullptr) {
+        if (!validVertex(u) || !validVertex(v)) return false;
+        Edge* e = findEdge(adj[u], v);
+        if (!e) return false;
+        double prev = e->weight;
+        if (oldWeight) *oldWeight = prev;
+        e->weight = w;
+        Edge* mirror = findMirror(undirectedGraph ? adj[v] : radj[v], u, prev);
+        if (mirror) mirror->weight = w;
+        versionCounter++;
+        return true;
+    }
+
+    bool removeEdge(int u, int v, double* oldWeight = nullptr) {
+        if (!validVertex(u) || !validVertex(v)) return false;
+        Edge* e = findEdge(adj[u], v);
+        if (!e) return false;
+        double prev = e->weight;
+        if (oldWeight) *oldWeight = prev;
+        eraseEdge(adj[u], e);
+        EdgeList& other = undirectedGraph ? adj[v] : radj[v];
+        Edge* mirror = findMirror(other, u, prev);
+        if (mirror) eraseEdge(other, mirror);
+        nEdges--;
+        versionCounter++;
+        structureCounter++;
+        return true;
+    }
+
 private:
     int nVertices;
     long long nEdges;
-    std::vector<std::vector<Edge>> adj;
+    bool undirectedGraph;
+    unsigned long long versionCounter;
+    unsigned long long structureCounter;
+    TrackedVector<EdgeList, MemComponent::Graph> adj;
+    TrackedVector<EdgeList, MemComponent::Graph> radj; // only filled for directed loads
+
+    bool validVertex(int u) const {
+        return u >= 0 && u < nVertices;
+    }
+
+    static Edge* findEdge(EdgeList& list, int to) {
+        for (auto& e : list) {
+            if (e.to == to) return &e;
+        }
+        return nullptr;
+    }
+
+    // Reverse copy of an edge; prefer the one with the same weight so that
+    // parallel edges stay paired up.
+    static Edge* findMirror(EdgeList& list, int to, double weight) {
+        for (auto& e : list) {
+            if (e.to == to && e.weight == weight) return &e;
+        }
+        return findEdge(list, to);
+    }
+
+    static void eraseEdge(EdgeList& list, Edge* e) {
+        // order of adjacency lists is irrelevant, so swap-and-pop
+        *e = list.back();
+        list.pop_back();
+    }
 };
 
 #endif // GRAPH_H
@@ -0,0 +1,268 @@
+// graph_components.h
+#ifndef GRAPH_COMPONENTS_H
+#define GRAPH_COMPONENTS_H
+
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <numeric>
+#include <utility>
+#include <cstdint>
+#include "graph.h"
+#include "priority_queue.h"
+#include "dijkstra.h"
+
+// Connectivity precomputed once per edge set, so that hopeless queries are
+// answered without a search and an SSSP only allocates for the vertices it
+// can reach.
+//
+//   undirected   connected components by union-find
+//   directed     weakly connected components by union-find (nothing outside
+//                the source's one is reachable), plus strongly connected
+//                components by an iterative Tarjan. Tarjan numbers the SCCs
+//                in reverse topological order, so an edge A -> B between
+//                SCCs has id(A) > id(B): t cannot be reached from s when
+//                id(scc(s)) < id(scc(t)).
+//
+// Only depends on which edges exist, not on their weights (see
+// Graph::structureVersion).
+
+enum class Reachability : uint8_t {
+    No,    // certainly unreachable
+    Yes,   // certainly reachable
+    Maybe  // directed graphs only: different SCCs in a possible order
+};
+
+class GraphComponents {
+public:
+    GraphComponents() = default;
+    explicit GraphComponents(const Graph& g) { build(g); }
+
+    void build(const Graph& g) {
+        n = g.numVertices();
+        isDirected = !g.isUndirected();
+        builtFor = g.structureVersion();
+        buildWeak(g);
+        if (isDirected) {
+            buildStrong(g);
+        } else {
+            strongOf.clear();
+            numStrong = numWeak;
+        }
+    }
+
+    // True if built for g's current edge set.
+    bool matches(const Graph& g) const {
+        return g.numVertices() == n && g.structureVersion() == builtFor
+            && isDirected == !g.isUndirected();
+    }
+
+    bool directed() const { return isDirected; }
+
+    // (Weakly) connected components, numbered 0 .. numComponents() - 1 in
+    // order of their smallest vertex.
+    int numComponents() const { return numWeak; }
+    int component(int v) const { return weakOf[v]; }
+    int componentSize(int c) const { return start[c + 1] - start[c]; }
+
+    int largestComponent() const {
+        int best = 0;
+        for (int c = 1; c < numWeak; ++c) {
+            if (componentSize(c) > componentSize(best)) best = c;
+        }
+        return best;
+    }
+
+    // Vertices of component c are vertexAt(c, 0 .. componentSize(c) - 1);
+    // localIndex(v) is v's position there.
+    int vertexAt(int c, int i) const { return members[start[c] + i]; }
+    int localIndex(int v) const { return local[v]; }
+
+    // Strongly connected components; the same as the components above for
+    // undirected graphs.
+    int numStrongComponents() const { return numStrong; }
+    int strongComponent(int v) const { return isDirected ? strongOf[v] : weakOf[v]; }
+
+    Reachability reachability(int s, int t) const {
+        if (weakOf[s] != weakOf[t]) return Reachability::No;
+        if (!isDirected) return Reachability::Yes;
+        if (strongOf[s] == strongOf[t]) return Reachability::Yes;
+        return strongOf[s] < strongOf[t] ? Reachability::No : Reachability::Maybe;
+    }
+
+private:
+    int n = 0;
+    bool isDirected = false;
+    unsigned long long builtFor = 0;
+    int numWeak = 0;
+    int numStrong = 0;
+    std::vector<int> weakOf;
+    std::vector<int> strongOf; // directed graphs only
+    std::vector<int> start;    // component c owns members[start[c] .. start[c+1])
+    std::vector<int> members;
+    std::vector<int> local;
+
+    // Union-find with path halving and union by size.
+    static int findRoot(std::vector<int>& up, int v) {
+        while (up[v] != v) {
+            up[v] = up[up[v]];
+            v = up[v];
+        }
+        return v;
+    }
+
+    void buildWeak(const Graph& g) {
+        std::vector<int> up(n), size(n, 1);
+        std::iota(up.begin(), up.end(), 0);
+        for (int u = 0; u < n; ++u) {
+            for (const auto& e : g.neighbors(u)) {
+                int a = findRoot(up, u), b = findRoot(up, e.to);
+                if (a == b) continue;
+                if (size[a] < size[b]) std::swap(a, b);
+                up[b] = a;
+                size[a] += size[b];
+            }
+        }
+
+        weakOf.assign(n, -1);
+        std::vector<int> idOfRoot(n, -1);
+        numWeak = 0;
+        for (int v = 0; v < n; ++v) {
+            int r = findRoot(up, v);
+            if (idOfRoot[r] < 0) idOfRoot[r] = numWeak++;
+            weakOf[v] = idOfRoot[r];
+        }
+
+        start.assign(numWeak + 1, 0);
+        for (int v = 0; v < n; ++v) start[weakOf[v] + 1]++;
+        for (int c = 0; c < numWeak; ++c) start[c + 1] += start[c];
+        members.assign(n, 0);
+        local.assign(n, 0);
+        std::vector<int> fill(start.begin(), start.end() - 1);
+        for (int v = 0; v < n; ++v) {
+            int c = weakOf[v];
+            local[v] = fill[c] - start[c];
+            members[fill[c]++] = v;
+        }
+    }
+
+    // Tarjan's algorithm with an explicit stack, so long road chains cannot
+    // overflow the call stack.
+    void buildStrong(const Graph& g) {
+        const int unvisited = -1;
+        strongOf.assign(n, -1);
+        std::vector<int> index(n, unvisited), low(n, 0);
+        std::vector<char> onStack(n, 0);
+        std::vector<int> sccStack;
+        std::vector<std::pair<int, size_t>> call; // (vertex, next edge)
+        int counter = 0;
+        numStrong = 0;
+
+        for (int root = 0; root < n; ++root) {
+            if (index[root] != unvisited) continue;
+            call.emplace_back(root, 0);
+            index[root] = low[root] = counter++;
+            sccStack.push_back(root);
+            onStack[root] = 1;
+
+            while (!call.empty()) {
+                int u = call.back().first;
+                size_t& k = call.back().second;
+                const EdgeList& edges = g.neighbors(u);
+                if (k < edges.size()) {
+                    int v = edges[k++].to;
+                    if (index[v] == unvisited) {
+                        index[v] = low[v] = counter++;
+                        sccStack.push_back(v);
+                        onStack[v] = 1;
+                        call.emplace_back(v, 0);
+                    } else if (onStack[v] && index[v] < low[u]) {
+                        low[u] = index[v];
+                    }
+                    continue;
+                }
+                call.pop_back();
+                if (!call.empty()) {
+                    int parent = call.back().first;
+                    if (low[u] < low[parent]) low[parent] = low[u];
+                }
+                if (low[u] == index[u]) {
+                    int v;
+                    do {
+                        v = sccStack.back();
+                        sccStack.pop_back();
+                        onStack[v] = 0;
+                        strongOf[v] = numStrong;
+                    } while (v != u);
+                    numStrong++;
+                }
+            }
+        }
+    }
+};
+
+// SSSP confined to the source's (weakly) connected component: dist and
+// parent are indexed by GraphComponents::localIndex, so the buffers are the
+// size of the component rather than of the graph. Vertices of other
+// components are unreachable.
+struct ComponentDijkstraResult {
+    int component = -1;
+    DijkstraBuffer<double> dist;  // by local index
+    DijkstraBuffer<int> parent;   // global vertex ids, -1 for the source
+
+    double distTo(const GraphComponents& comps, int v) const {
+        if (comps.component(v) != component) return std::numeric_limits<double>::infinity();
+        return dist[comps.localIndex(v)];
+    }
+};
+
+template <typename PQType>
+ComponentDijkstraResult runDijkstraInComponent(const Graph& g, const GraphComponents& comps,
+                                               int source, DijkstraMetrics& metrics) {
+    ComponentDijkstraResult res;
+    res.component = comps.component(source);
+    int size = comps.componentSize(res.component);
+    res.dist.assign(size, std::numeric_limits<double>::infinity());
+    res.parent.assign(size, -1);
+    DijkstraBuffer<PQNodeBase*> handles(size, nullptr);
+
+    PQType pq;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    int ls = comps.localIndex(source);
+    res.dist[ls] = 0.0;
+    handles[ls] = pq.insert(0.0, ls);
+    metrics.inserts++;
+
+    while (!pq.empty()) {
+        auto [d, lu] = pq.extract_min();
+        metrics.extractMins++;
+        if (d > res.dist[lu]) continue;
+        int u = comps.vertexAt(res.component, lu);
+
+        for (const auto& e : g.neighbors(u)) {
+            int lv = comps.localIndex(e.to);
+            double nd = d + e.weight;
+            if (nd < res.dist[lv]) {
+                res.dist[lv] = nd;
+                res.parent[lv] = u;
+                if (handles[lv] == nullptr) {
+                    handles[lv] = pq.insert(nd, lv);
+                    metrics.inserts++;
+                } else {
+                    pq.decrease_key(handles[lv], nd);
+                    metrics.decreaseKeys++;
+                }
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    metrics.runtimeMs =
+        std::chrono::duration<double, std::milli>(end - start).count();
+
+    return res;
+}
+
+#endif // GRAPH_COMPONENTS_H
@@ -0,0 +1,282 @@
+// graph_generators.h
+#ifndef GRAPH_GENERATORS_H
+#define GRAPH_GENERATORS_H
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include "graph.h"
+
+// Synthetic inputs for scaling experiments. Every generator fills a Graph
+// directly (no intermediate edge list, so memory stays at the size of the
+// adjacency lists) and is a pure function of its parameters and seed; the
+// random numbers come from SplitMix64, so the same seed gives the same graph
+// on every platform. Use Graph::writeRoadD to save the result.
+
+// Small, fast, portable 64-bit generator (Steele et al., SplitMix).
+struct SplitMix64 {
+    uint64_t state;
+
+    explicit SplitMix64(uint64_t seed = 0) : state(seed) {}
+
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t next() {
+        state += 0x9e3779b97f4a7c15ull;
+        return mix(state);
+    }
+
+    // uniform in [0, 1)
+    double uniform() {
+        return (double)(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // uniform in [0, n)
+    uint64_t below(uint64_t n) {
+        return n ? next() % n : 0;
+    }
+
+    // Stateless variant: a uniform [0, 1) value derived from (seed, key), so
+    // a generator can ask for "the jitter of vertex v" in any order.
+    static double uniformAt(uint64_t seed, uint64_t key) {
+        return (double)(mix(seed ^ mix(key + 0x9e3779b97f4a7c15ull)) >> 11)
+             * (1.0 / 9007199254740992.0);
+    }
+};
+
+// --- Perturbed grid (road-like) ---
+// A rows x cols lattice whose points are displaced by up to jitter * spacing.
+// Some lattice edges are dropped (blocks, dead ends), some diagonals added
+// (shortcuts), and every weight is the Euclidean length stretched by a random
+// detour factor, so the graph has the bounded degree, planarity-ish structure
+// and large diameter of a road network.
+struct GridGraphOptions {
+    double spacing = 100.0;           // metres between neighbouring lattice points
+    double jitter = 0.3;              // max displacement, fraction of spacing
+    double dropProbability = 0.15;    // lattice edges removed
+    double diagonalProbability = 0.05; // diagonals added per cell
+    double maxDetour = 0.3;           // weight = length * (1 + U[0, maxDetour])
+};
+
+inline bool generateGridGraph(Graph& g, int rows, int cols, uint64_t seed,
+                              const GridGraphOptions& opt = GridGraphOptions(),
+                              bool undirected = true) {
+    if (rows <= 0 || cols <= 0 || (long long)rows * cols > 2147483647LL) {
+        std::cerr << "Error: grid size " << rows << "x" << cols << " out of range" << std::endl;
+        return false;
+    }
+    int n = rows * cols;
+    g.reset(n, undirected);
+
+    auto x = [&](int v) {
+        return (v % cols + opt.jitter * (2.0 * SplitMix64::uniformAt(seed, 2 * (uint64_t)v) - 1.0))
+               * opt.spacing;
+    };
+    auto y = [&](int v) {
+        return (v / cols + opt.jitter * (2.0 * SplitMix64::uniformAt(seed, 2 * (uint64_t)v + 1) - 1.0))
+               * opt.spacing;
+    };
+    // Keys for edge decisions live above the 2n keys used for coordinates.
+    uint64_t edgeKey = 2 * (uint64_t)n;
+    auto connect = [&](int u, int v, double keepProbability) {
+        uint64_t k = edgeKey;
+        edgeKey += 2;
+        if (SplitMix64::uniformAt(seed, k) >= keepProbability) return;
+        double len = std::hypot(x(u) - x(v), y(u) - y(v));
+        double w = len * (1.0 + opt.maxDetour * SplitMix64::uniformAt(seed, k + 1));
+        g.addEdge(u, v, w);
+    };
+
+    double keep = 1.0 - opt.dropProbability;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            int v = r * cols + c;
+            if (c + 1 < cols) connect(v, v + 1, keep);
+            if (r + 1 < rows) connect(v, v + cols, keep);
+            if (r + 1 < rows && c + 1 < cols) {
+                // at most one diagonal per cell, so the graph stays near-planar
+                bool forward = SplitMix64::uniformAt(seed, edgeKey++) < 0.5;
+                if (forward) connect(v, v + cols + 1, opt.diagonalProbability);
+                else connect(v + 1, v + cols, opt.diagonalProbability);
+            }
+        }
+    }
+    return true;
+}
+
+// --- Random geometric graph ---
+// n points uniform in a square sized so that neighbouring points are about
+// `spacing` metres apart; every pair closer than the radius that gives the
+// requested expected degree is connected, weighted by its length.
+inline bool generateRandomGeometricGraph(Graph& g, int n, double avgDegree, uint64_t seed,
+                                         double spacing = 100.0, bool undirected = true) {
+    if (n <= 0 || avgDegree <= 0.0) {
+        std::cerr << "Error: random geometric graph needs n > 0 and degree > 0" << std::endl;
+        return false;
+    }
+    const double pi = 3.14159265358979323846;
+    double side = std::sqrt((double)n) * spacing;
+    double radius = spacing * std::sqrt(avgDegree / pi);
+    int cellsPerSide = std::max(1, (int)std::min(side / radius, 46340.0));
+    double cellSize = side / cellsPerSide;
+    long long numCells = (long long)cellsPerSide * cellsPerSide;
+
+    SplitMix64 rng(seed);
+    std::vector<float> px(n), py(n);
+    std::vector<int> cellStart(numCells + 1, 0);
+    auto cellOf = [&](int i) {
+        int cx = std::min(cellsPerSide - 1, (int)(px[i] / cellSize));
+        int cy = std::min(cellsPerSide - 1, (int)(py[i] / cellSize));
+        return (long long)cy * cellsPerSide + cx;
+    };
+    for (int i = 0; i < n; ++i) {
+        px[i] = (float)(rng.uniform() * side);
+        py[i] = (float)(rng.uniform() * side);
+        cellStart[cellOf(i) + 1]++;
+    }
+    for (long long c = 0; c < numCells; ++c) cellStart[c + 1] += cellStart[c];
+    std::vector<int> byCell(n);
+    {
+        std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+        for (int i = 0; i < n; ++i) byCell[fill[cellOf(i)]++] = i;
+    }
+
+    g.reset(n, undirected);
+    double r2 = radius * radius;
+    for (long long c = 0; c < numCells; ++c) {
+        int cx = (int)(c % cellsPerSide);
+        int cy = (int)(c / cellsPerSide);
+        for (int a = cellStart[c]; a < cellStart[c + 1]; ++a) {
+            int u = byCell[a];
+            // visit each unordered pair once: same cell (later points only)
+            // and the four neighbouring cells "after" this one
+            static const int dx[] = {0, 1, -1, 0, 1};
+            static const int dy[] = {0, 0, 1, 1, 1};
+            for (int k = 0; k < 5; ++k) {
+                int nx = cx + dx[k], ny = cy + dy[k];
+                if (nx < 0 || nx >= cellsPerSide || ny >= cellsPerSide) continue;
+                long long nc = (long long)ny * cellsPerSide + nx;
+                int b = (k == 0) ? a + 1 : cellStart[nc];
+                for (; b < cellStart[nc + 1]; ++b) {
+                    int v = byCell[b];
+                    double ddx = (double)px[u] - px[v];
+                    double ddy = (double)py[u] - py[v];
+                    double d2 = ddx * ddx + ddy * ddy;
+                    if (d2 <= r2) g.addEdge(u, v, std::sqrt(d2));
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// --- R-MAT ---
+// 2^scale vertices and edgeFactor * 2^scale edges drawn by recursive
+// quadrant selection (Chakrabarti et al.), with the Graph500 defaults
+// a=0.57, b=c=0.19. Produces the skewed, low-diameter degree distribution of
+// social / web graphs. Vertex ids are scrambled by a bijection so that high
+// degree vertices are not clustered at small ids; self-loops are dropped,
+// duplicate edges kept. Weights are uniform in [1, maxWeight].
+struct RMatOptions {
+    double a = 0.57;
+    double b = 0.19;
+    double c = 0.19;
+    double maxWeight = 100.0;
+    bool scramble = true;
+};
+
+inline bool generateRMatGraph(Graph& g, int scale, double edgeFactor, uint64_t seed,
+                              const RMatOptions& opt = RMatOptions(), bool undirected = false) {
+    if (scale < 1 || scale > 30 || edgeFactor <= 0.0) {
+        std::cerr << "Error: R-MAT needs 1 <= scale <= 30 and edge factor > 0" << std::endl;
+        return false;
+    }
+    if (opt.a + opt.b + opt.c >= 1.0) {
+        std::cerr << "Error: R-MAT probabilities a + b + c must be < 1" << std::endl;
+        return false;
+    }
+    uint64_t n = 1ull << scale;
+    uint64_t mask = n - 1;
+    long long m = (long long)(edgeFactor * (double)n);
+    // odd multiplier => bijection on [0, 2^scale)
+    uint64_t mult = (SplitMix64::mix(seed) | 1ull) & mask;
+    uint64_t offset = SplitMix64::mix(seed + 1) & mask;
+    auto scrambleId = [&](uint64_t v) {
+        return opt.scramble ? (int)((v * mult + offset) & mask) : (int)v;
+    };
+
+    g.reset((int)n, undirected);
+    SplitMix64 rng(seed);
+    double ab = opt.a + opt.b;
+    double abc = ab + opt.c;
+    for (long long i = 0; i < m; ++i) {
+        uint64_t u = 0, v = 0;
+        for (int level = 0; level < scale; ++level) {
+            double p = rng.uniform();
+            u <<= 1;
+            v <<= 1;
+            if (p < opt.a) {
+                // top-left
+            } else if (p < ab) {
+                v |= 1;
+            } else if (p < abc) {
+                u |= 1;
+            } else {
+                u |= 1;
+                v |= 1;
+            }
+        }
+        double w = 1.0 + (opt.maxWeight - 1.0) * rng.uniform();
+        if (u == v) continue;
+        g.addEdge(scrambleId(u), scrambleId(v), w);
+    }
+    return true;
+}
+
+// Builds a graph from a short spec, as accepted by graph_gen and bench --gen:
+//   grid:ROWSxCOLS       perturbed grid (road-like)
+//   rgg:N:DEGREE         random geometric graph
+//   rmat:SCALE:FACTOR    R-MAT, 2^SCALE vertices, FACTOR * 2^SCALE edges
+inline bool generateGraphFromSpec(Graph& g, const std::string& spec, uint64_t seed,
+                                  bool undirected = true) {
+    std::vector<std::string> parts;
+    size_t start = 0;
+    while (true) {
+        size_t pos = spec.find(':', start);
+        parts.push_back(spec.substr(start, pos - start));
+        if (pos == std::string::npos) break;
+        start = pos + 1;
+    }
+    try {
+        if (parts[0] == "grid" && parts.size() == 2) {
+            size_t x = parts[1].find('x');
+            if (x == std::string::npos) throw std::invalid_argument(spec);
+            int rows = std::stoi(parts[1].substr(0, x));
+            int cols = std::stoi(parts[1].substr(x + 1));
+            return generateGridGraph(g, rows, cols, seed, GridGraphOptions(), undirected);
+        }
+        if (parts[0] == "rgg" && parts.size() == 3) {
+            return generateRandomGeometricGraph(g, std::stoi(parts[1]), std::stod(parts[2]),
+                                                seed, 100.0, undirected);
+        }
+        if (parts[0] == "rmat" && parts.size() == 3) {
+            return generateRMatGraph(g, std::stoi(parts[1]), std::stod(parts[2]), seed,
+                                     RMatOptions(), undirected);
+        }
+    } catch (const std::exception&) {
+        // fall through to the error below
+    }
+    std::cerr << "Error: bad graph spec '" << spec
+              << "' (expected grid:RxC, rgg:N:DEGREE or rmat:SCALE:FACTOR)" << std::endl;
+    return false;
+}
+
+#endif // GRAPH_GENERATORS_H
@@ -0,0 +1,357 @@
+// graph_partition.h
+#ifndef GRAPH_PARTITION_H
+#define GRAPH_PARTITION_H
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include "graph.h"
+#include "graph_generators.h"
+
+// Partition of a Graph into cells of at most maxCellSize vertices with few
+// cut edges, for overlay routing (crp_overlay.h). Road-d files carry no
+// coordinates, so instead of inertial flow this is multilevel recursive
+// bisection in the METIS mould:
+//
+//   coarsen   heavy-edge matching in random order, until the graph is
+//             small or stops shrinking
+//   split     BFS growing from a pseudo-peripheral vertex (and a few
+//             random ones) on the coarsest graph; the best cut wins
+//   refine    at every level on the way back, boundary vertices move to
+//             the other side while that lowers the cut and keeps balance
+//
+// Edge directions and weights are ignored; the cut counts adjacent vertex
+// pairs, which is what the overlay pays for.
+
+struct PartitionOptions {
+    int maxCellSize = 1024;
+    double imbalance = 0.05; // a bisection side holds at most (1 + imbalance) / 2
+    int coarsenTo = 128;     // stop coarsening below this many vertices
+    int initialTries = 4;    // BFS-growing starts on the coarsest graph
+    int refinePasses = 8;    // greedy refinement passes per level, at most
+    uint64_t seed = 1;
+};
+
+struct GraphPartition {
+    int numCells = 0;
+    std::vector<int> cellOf; // vertex -> cell
+    long long cutEdges = 0;  // edges between cells (undirected edges once)
+
+    std::vector<int> cellSizes() const {
+        std::vector<int> sizes(numCells, 0);
+        for (int c : cellOf) sizes[c]++;
+        return sizes;
+    }
+};
+
+namespace partition_detail {
+
+// Undirected, vertex- and edge-weighted graph in CSR form.
+struct LevelGraph {
+    std::vector<int> xadj{0};
+    std::vector<int> adjncy;
+    std::vector<int> adjwgt;
+    std::vector<int> vwgt;
+    long long totalVwgt = 0;
+
+    int n() const { return (int)vwgt.size(); }
+};
+
+// Subgraph induced by verts. localId must be -1 everywhere on entry and is
+// restored on exit. Parallel and opposite edges merge into one weight.
+inline LevelGraph induce(const Graph& g, const std::vector<int>& verts, std::vector<int>& localId) {
+    LevelGraph lg;
+    int n = (int)verts.size();
+    for (int i = 0; i < n; ++i) localId[verts[i]] = i;
+    lg.vwgt.assign(n, 1);
+    lg.totalVwgt = n;
+    std::vector<int> pos(n, -1);
+    for (int i = 0; i < n; ++i) {
+        int u = verts[i];
+        size_t rowStart = lg.adjncy.size();
+        auto add = [&](int v) {
+            int j = localId[v];
+            if (j < 0 || j == i) return;
+            if (pos[j] < 0) {
+                pos[j] = (int)lg.adjncy.size();
+                lg.adjncy.push_back(j);
+                lg.adjwgt.push_back(1);
+            } else {
+                lg.adjwgt[pos[j]]++;
+            }
+        };
+        for (const auto& e : g.neighbors(u)) add(e.to);
+        if (!g.isUndirected()) {
+            for (const auto& e : g.inNeighbors(u)) add(e.to);
+        }
+        for (size_t k = rowStart; k < lg.adjncy.size(); ++k) pos[lg.adjncy[k]] = -1;
+        lg.xadj.push_back((int)lg.adjncy.size());
+    }
+    for (int v : verts) localId[v] = -1;
+    return lg;
+}
+
+// One level of heavy-edge matching. map[u] is u's vertex in the result.
+inline LevelGraph coarsen(const LevelGraph& fine, std::vector<int>& map, int maxVwgt,
+                          SplitMix64& rng) {
+    int n = fine.n();
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    for (int i = n - 1; i > 0; --i) std::swap(order[i], order[rng.below(i + 1)]);
+
+    std::vector<int> match(n, -1);
+    map.assign(n, -1);
+    int nc = 0;
+    for (int u : order) {
+        if (match[u] >= 0) continue;
+        int best = u, bestW = 0;
+        for (int k = fine.xadj[u]; k < fine.xadj[u + 1]; ++k) {
+            int v = fine.adjncy[k];
+            if (match[v] >= 0 || fine.vwgt[u] + fine.vwgt[v] > maxVwgt) continue;
+            if (fine.adjwgt[k] > bestW) {
+                best = v;
+                bestW = fine.adjwgt[k];
+            }
+        }
+        match[u] = best;
+        match[best] = u;
+        map[u] = map[best] = nc++;
+    }
+
+    LevelGraph c;
+    c.vwgt.assign(nc, 0);
+    c.totalVwgt = fine.totalVwgt;
+    std::vector<int> members(2 * nc, -1);
+    for (int u = 0; u < n; ++u) {
+        int cu = map[u];
+        c.vwgt[cu] += fine.vwgt[u];
+        members[2 * cu + (members[2 * cu] < 0 ? 0 : 1)] = u;
+    }
+    std::vector<int> pos(nc, -1);
+    for (int cu = 0; cu < nc; ++cu) {
+        size_t rowStart = c.adjncy.size();
+        for (int m = 0; m < 2; ++m) {
+            int u = members[2 * cu + m];
+            if (u < 0) continue;
+            for (int k = fine.xadj[u]; k < fine.xadj[u + 1]; ++k) {
+                int cv = map[fine.adjncy[k]];
+                if (cv == cu) continue;
+                if (pos[cv] < 0) {
+                    pos[cv] = (int)c.adjncy.size();
+                    c.adjncy.push_back(cv);
+                    c.adjwgt.push_back(fine.adjwgt[k]);
+                } else {
+                    c.adjwgt[pos[cv]] += fine.adjwgt[k];
+                }
+            }
+        }
+        for (size_t k = rowStart; k < c.adjncy.size(); ++k) pos[c.adjncy[k]] = -1;
+        c.xadj.push_back((int)c.adjncy.size());
+    }
+    return c;
+}
+
+inline long long cutWeight(const LevelGraph& lg, const std::vector<char>& side) {
+    long long cut = 0;
+    for (int u = 0; u < lg.n(); ++u) {
+        for (int k = lg.xadj[u]; k < lg.xadj[u + 1]; ++k) {
+            if (side[u] != side[lg.adjncy[k]]) cut += lg.adjwgt[k];
+        }
+    }
+    return cut / 2;
+}
+
+// Edge weight from u to the other side minus edge weight to its own side.
+inline long long moveGain(const LevelGraph& lg, const std::vector<char>& side, int u) {
+    long long gain = 0;
+    for (int k = lg.xadj[u]; k < lg.xadj[u + 1]; ++k) {
+        gain += side[lg.adjncy[k]] != side[u] ? lg.adjwgt[k] : -lg.adjwgt[k];
+    }
+    return gain;
+}
+
+// Greedy boundary refinement. First restores balance by moving the best
+// vertices off an overweight side, then moves any vertex whose move lowers
+// the cut (or keeps it and evens the sides) without breaking balance.
+inline void refine(const LevelGraph& lg, std::vector<char>& side, long long maxSide, int passes) {
+    int n = lg.n();
+    long long w[2] = {0, 0};
+    for (int u = 0; u < n; ++u) w[(int)side[u]] += lg.vwgt[u];
+
+    for (int heavy = 0; heavy < 2; ++heavy) {
+        while (w[heavy] > maxSide) {
+            std::vector<std::pair<long long,int>> cand;
+            for (int u = 0; u < n; ++u) {
+                if (side[u] == heavy) cand.emplace_back(-moveGain(lg, side, u), u);
+            }
+            std::sort(cand.begin(), cand.end());
+            bool moved = false;
+            for (const auto& c : cand) {
+                int u = c.second;
+                if (w[heavy] <= maxSide) break;
+                if (w[1 - heavy] + lg.vwgt[u] > maxSide) continue;
+                side[u] = (char)(1 - heavy);
+                w[heavy] -= lg.vwgt[u];
+                w[1 - heavy] += lg.vwgt[u];
+                moved = true;
+            }
+            if (!moved) break; // vertex weights too coarse to balance here
+        }
+    }
+
+    for (int pass = 0; pass < passes; ++pass) {
+        bool improved = false;
+        for (int u = 0; u < n; ++u) {
+            int from = side[u], to = 1 - from;
+            if (w[to] + lg.vwgt[u] > maxSide) continue;
+            long long gain = moveGain(lg, side, u);
+            if (gain > 0 || (gain == 0 && w[from] > w[to] + lg.vwgt[u])) {
+                side[u] = (char)to;
+                w[from] -= lg.vwgt[u];
+                w[to] += lg.vwgt[u];
+                if (gain > 0) improved = true;
+            }
+        }
+        if (!improved) break;
+    }
+}
+
+// Last vertex reached by a BFS from start (ties to the lowest id).
+inline int farthestVertex(const LevelGraph& lg, int start) {
+    std::vector<char> seen(lg.n(), 0);
+    std::vector<int> queue{start};
+    seen[start] = 1;
+    for (size_t h = 0; h < queue.size(); ++h) {
+        int u = queue[h];
+        for (int k = lg.xadj[u]; k < lg.xadj[u + 1]; ++k) {
+            int v = lg.adjncy[k];
+            if (!seen[v]) {
+                seen[v] = 1;
+                queue.push_back(v);
+            }
+        }
+    }
+    return queue.back();
+}
+
+// Side 1 = the first half of the weight reached by BFS from start; the BFS
+// jumps to the next unreached vertex when a component runs out.
+inline std::vector<char> growBisection(const LevelGraph& lg, int start) {
+    int n = lg.n();
+    std::vector<char> side(n, 0), seen(n, 0);
+    std::vector<int> queue;
+    long long grown = 0, target = lg.totalVwgt / 2;
+    int nextSeed = 0;
+    queue.push_back(start);
+    seen[start] = 1;
+    size_t h = 0;
+    while (grown < target) {
+        if (h == queue.size()) {
+            while (nextSeed < n && seen[nextSeed]) ++nextSeed;
+            if (nextSeed == n) break;
+            seen[nextSeed] = 1;
+            queue.push_back(nextSeed);
+        }
+        int u = queue[h++];
+        side[u] = 1;
+        grown += lg.vwgt[u];
+        for (int k = lg.xadj[u]; k < lg.xadj[u + 1]; ++k) {
+            int v = lg.adjncy[k];
+            if (!seen[v]) {
+                seen[v] = 1;
+                queue.push_back(v);
+            }
+        }
+    }
+    return side;
+}
+
+// Two-way split of lg: multilevel coarsening, best of several grown
+// bisections on the coarsest graph, refinement on the way back up.
+inline std::vector<char> bisect(const LevelGraph& lg, const PartitionOptions& opt, SplitMix64& rng) {
+    long long maxSide = (long long)((1.0 + opt.imbalance) * (double)lg.totalVwgt / 2.0) + 1;
+    std::vector<LevelGraph> levels;
+    std::vector<std::vector<int>> maps;
+    const LevelGraph* cur = &lg;
+    int maxVwgt = (int)std::max<long long>(1, (long long)(1.5 * (double)lg.totalVwgt / opt.coarsenTo));
+    while (cur->n() > opt.coarsenTo) {
+        std::vector<int> map;
+        LevelGraph next = coarsen(*cur, map, maxVwgt, rng);
+        if (next.n() > cur->n() * 95 / 100) break;
+        maps.push_back(std::move(map));
+        levels.push_back(std::move(next));
+        cur = &levels.back();
+    }
+
+    std::vector<char> best;
+    long long bestCut = -1;
+    int tries = std::max(1, opt.initialTries);
+    for (int t = 0; t < tries; ++t) {
+        int start = (int)rng.below(cur->n());
+        if (t == 0) start = farthestVertex(*cur, farthestVertex(*cur, start));
+        std::vector<char> side = growBisection(*cur, start);
+        refine(*cur, side, maxSide, opt.refinePasses);
+        long long cut = cutWeight(*cur, side);
+        if (bestCut < 0 || cut < bestCut) {
+            bestCut = cut;
+            best = std::move(side);
+        }
+    }
+
+    for (int l = (int)levels.size() - 1; l >= 0; --l) {
+        const LevelGraph& fine = l == 0 ? lg : levels[l - 1];
+        std::vector<char> side(fine.n());
+        for (int u = 0; u < fine.n(); ++u) side[u] = best[maps[l][u]];
+        refine(fine, side, maxSide, opt.refinePasses);
+        best = std::move(side);
+    }
+    return best;
+}
+
+} // namespace partition_detail
+
+// Recursive bisection until every cell has at most opt.maxCellSize vertices.
+inline GraphPartition partitionGraph(const Graph& g, const PartitionOptions& opt = PartitionOptions()) {
+    using namespace partition_detail;
+    GraphPartition p;
+    int n = g.numVertices();
+    p.cellOf.assign(n, -1);
+    int maxCell = std::max(1, opt.maxCellSize);
+    SplitMix64 rng(opt.seed);
+    std::vector<int> localId(n, -1);
+
+    std::vector<std::vector<int>> work;
+    work.emplace_back(n);
+    std::iota(work.back().begin(), work.back().end(), 0);
+    while (!work.empty()) {
+        std::vector<int> verts = std::move(work.back());
+        work.pop_back();
+        if ((int)verts.size() <= maxCell) {
+            for (int v : verts) p.cellOf[v] = p.numCells;
+            p.numCells++;
+            continue;
+        }
+        LevelGraph lg = induce(g, verts, localId);
+        std::vector<char> side = bisect(lg, opt, rng);
+        std::vector<int> parts[2];
+        for (int i = 0; i < (int)verts.size(); ++i) parts[(int)side[i]].push_back(verts[i]);
+        if (parts[0].empty() || parts[1].empty()) {
+            // cannot happen with a sane balance bound; split by position
+            parts[0].assign(verts.begin(), verts.begin() + verts.size() / 2);
+            parts[1].assign(verts.begin() + verts.size() / 2, verts.end());
+        }
+        work.push_back(std::move(parts[1]));
+        work.push_back(std::move(parts[0]));
+    }
+
+    for (int u = 0; u < n; ++u) {
+        for (const auto& e : g.neighbors(u)) {
+            if (p.cellOf[u] != p.cellOf[e.to]) p.cutEdges++;
+        }
+    }
+    if (g.isUndirected()) p.cutEdges /= 2;
+    return p;
+}
+
+#endif // GRAPH_PARTITION_H
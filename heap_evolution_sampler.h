@@ -0,0 +1,157 @@
+// heap_evolution_sampler.h
+#ifndef HEAP_EVOLUTION_SAMPLER_H
+#define HEAP_EVOLUTION_SAMPLER_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include "dijkstra.h"
+
+// One snapshot of a heap's structure during a Dijkstra run.
+struct HeapSample {
+    long long step;
+    int heapSize;
+    int heapHeight;
+    int numTrees;
+    long long cascadingCuts;
+    long long inserts;
+    long long extractMins;
+    long long decreaseKeys;
+};
+
+// Collects HeapSamples from inside a timed loop without doing any I/O there.
+// The search thread copies each sample into a preallocated single-producer /
+// single-consumer ring; a background thread drains the ring to disk. If the
+// writer ever falls a full ring behind, samples are dropped (and counted)
+// rather than stalling the search.
+//
+//   HeapEvolutionSampler sampler;
+//   sampler.open("heap_evolution_fibonacci.csv");
+//   runDijkstraTracked<FibonacciHeap>(g, 0, metrics, sampler, 1000);
+//   sampler.close();
+//
+// The sample getters it calls must be O(1); all heaps in this repo keep their
+// size, height and root counts up to date incrementally.
+class HeapEvolutionSampler {
+public:
+    enum class Format { Csv, Binary };
+
+    // capacity is rounded up to a power of two
+    explicit HeapEvolutionSampler(size_t capacity = 1 << 16) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        ring.resize(cap);
+        mask = cap - 1;
+    }
+
+    ~HeapEvolutionSampler() {
+        close();
+    }
+
+    HeapEvolutionSampler(const HeapEvolutionSampler&) = delete;
+    HeapEvolutionSampler& operator=(const HeapEvolutionSampler&) = delete;
+
+    // Binary layout: "HES1" | u32 sizeof(HeapSample) | raw HeapSample records
+    bool open(const std::string& path, Format fmt = Format::Csv) {
+        close();
+        out.open(path, fmt == Format::Binary ? std::ios::binary : std::ios::out);
+        if (!out.is_open()) {
+            std::cerr << "Error: cannot open file " << path << std::endl;
+            return false;
+        }
+        format = fmt;
+        if (format == Format::Csv) {
+            out << "step,heapSize,heapHeight,numTrees,cascadingCuts,inserts,extractMins,decreaseKeys\n";
+        } else {
+            uint32_t recordSize = sizeof(HeapSample);
+            out.write("HES1", 4);
+            out.write(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+        }
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+        nDropped = 0;
+        nWritten = 0;
+        running.store(true, std::memory_order_release);
+        writer = std::thread([this] { writerLoop(); });
+        return true;
+    }
+
+    // Flushes everything still in the ring and stops the writer thread.
+    void close() {
+        if (!writer.joinable()) return;
+        running.store(false, std::memory_order_release);
+        writer.join();
+        out.close();
+    }
+
+    // Called from the search thread. Never blocks.
+    bool push(const HeapSample& s) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) > mask) {
+            ++nDropped;
+            return false;
+        }
+        ring[h & mask] = s;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Callback signature expected by runDijkstraTracked.
+    template <typename PQType>
+    void operator()(const PQType& pq, long long step, const DijkstraMetrics& m) {
+        push(HeapSample{step, pq.getSize(), pq.getHeightEstimate(), pq.getNumTrees(),
+                        pq.getNumCascadingCuts(), m.inserts, m.extractMins, m.decreaseKeys});
+    }
+
+    long long dropped() const { return nDropped; }
+    // Only meaningful after close().
+    long long written() const { return nWritten; }
+
+private:
+    std::vector<HeapSample> ring;
+    size_t mask = 0;
+    std::atomic<size_t> head{0}; // next slot the producer writes
+    std::atomic<size_t> tail{0}; // next slot the writer reads
+    std::atomic<bool> running{false};
+    long long nDropped = 0;
+    long long nWritten = 0;
+
+    std::thread writer;
+    std::ofstream out;
+    Format format = Format::Csv;
+
+    void writerLoop() {
+        while (true) {
+            // Read the flag first so the final drain sees every push made
+            // before close().
+            bool stop = !running.load(std::memory_order_acquire);
+            size_t t = tail.load(std::memory_order_relaxed);
+            size_t h = head.load(std::memory_order_acquire);
+            for (; t != h; ++t) {
+                write(ring[t & mask]);
+                ++nWritten;
+                tail.store(t + 1, std::memory_order_release);
+            }
+            if (stop) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        out.flush();
+    }
+
+    void write(const HeapSample& s) {
+        if (format == Format::Binary) {
+            out.write(reinterpret_cast<const char*>(&s), sizeof(s));
+            return;
+        }
+        out << s.step << "," << s.heapSize << "," << s.heapHeight << ","
+            << s.numTrees << "," << s.cascadingCuts << "," << s.inserts << ","
+            << s.extractMins << "," << s.decreaseKeys << "\n";
+    }
+};
+
+#endif // HEAP_EVOLUTION_SAMPLER_H
@@ -0,0 +1,51 @@
+// heap_registry.h
+#ifndef HEAP_REGISTRY_H
+#define HEAP_REGISTRY_H
+
+#include <string>
+#include <vector>
+#include "binary_heap.h"
+#include "fibonacci_heap.h"
+#include "hollow_heap.h"
+#include "rank_pairing_heap.h"
+#include "b_heap.h"
+#include "lazy_heap.h"
+#include "sequence_heap.h"
+
+// Maps heap names used on driver command lines to PriorityQueue types.
+// New implementations only need a line in withHeap() (and allHeapNames()).
+
+template <typename T>
+struct HeapTag { using type = T; };
+
+template <typename Fn>
+bool withHeap(const std::string& name, Fn&& fn) {
+    if (name == "binary")    { fn(HeapTag<BinaryHeap>{});    return true; }
+    if (name == "fibonacci") { fn(HeapTag<FibonacciHeap>{}); return true; }
+    if (name == "hollow")    { fn(HeapTag<HollowHeap>{});    return true; }
+    if (name == "rp1")       { fn(HeapTag<RankPairingHeap1>{}); return true; }
+    if (name == "rp2")       { fn(HeapTag<RankPairingHeap2>{}); return true; }
+    if (name == "bheap")     { fn(HeapTag<BHeap>{});         return true; }
+    return false;
+}
+
+inline std::vector<std::string> allHeapNames() {
+    return {"binary", "fibonacci", "hollow", "rp1", "rp2", "bheap"};
+}
+
+// Heaps without decrease_key, driven by runDijkstraLazy (dijkstra_lazy.h).
+// Kept apart because they do not implement PriorityQueue.
+template <typename Fn>
+bool withLazyHeap(const std::string& name, Fn&& fn) {
+    if (name == "lazy2") { fn(HeapTag<LazyBinaryHeap>{});     return true; }
+    if (name == "lazy4") { fn(HeapTag<LazyQuaternaryHeap>{}); return true; }
+    if (name == "seq")   { fn(HeapTag<SequenceHeap>{});       return true; }
+    if (name == "seqdisk") { fn(HeapTag<SpillingSequenceHeap>{}); return true; }
+    return false;
+}
+
+inline std::vector<std::string> allLazyHeapNames() {
+    return {"lazy2", "lazy4", "seq", "seqdisk"};
+}
+
+#endif // HEAP_REGISTRY_H
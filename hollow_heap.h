@@ -1,4 +1,3 @@
-%%writefile hollow_heap.h
 #ifndef HOLLOW_HEAP_H
 #define HOLLOW_HEAP_H
 
@@ -6,6 +5,7 @@
 #include <cmath>
 #include <limits>
 #include <unordered_map>
+#include <functional>
 #include "priority_queue.h"
 
 class HollowNode : public PQNodeBase {
@@ -29,28 +29,70 @@ public:
     static constexpr int MAX_RANK = 64;
 
     ~HollowHeap() override {
-        // Clean up all nodes
-        std::vector<HollowNode*> toDelete;
-        if (minNode) {
-            collectAllNodes(minNode, toDelete);
-        }
-        for (auto* node : toDelete) {
+        for (auto* node : allNodes) {
             delete node;
         }
     }
 
     PQNodeBase* insert(double key, int value) override {
-        auto* node = new HollowNode(key, value);
+        auto* node = newNode(key, value);
         minNode = meld(minNode, node);
         nNodes++;
         
         // Track the actual node pointer for this value
         valueToNode[value] = node;
         
-        updateHeapHeight();
+        currentRootCount++;
+        maxHeapHeight = std::max(maxHeapHeight, 1);
         return node;
     }
 
+    // Chains the batch as new roots and splices the chain into the root
+    // list once. The smallest new node goes to the front if it beats the
+    // current minimum, as meld() would do for a single node.
+    void bulk_insert(const std::pair<double,int>* items, size_t count,
+                     PQNodeBase** handles) override {
+        if (count == 0) return;
+        allNodes.reserve(allNodes.size() + count);
+        HollowNode* batchMin = nullptr;
+        HollowNode* head = nullptr; // the other new roots
+        HollowNode* tail = nullptr;
+        for (size_t i = 0; i < count; ++i) {
+            auto* node = newNode(items[i].first, items[i].second);
+            if (handles) handles[i] = node;
+            valueToNode[node->value] = node;
+            HollowNode* rest = node;
+            if (!batchMin || node->key < batchMin->key) {
+                rest = batchMin;
+                batchMin = node;
+            }
+            if (rest) {
+                rest->next = nullptr;
+                if (tail) tail->next = rest;
+                else head = rest;
+                tail = rest;
+            }
+        }
+
+        if (minNode == nullptr || batchMin->key < minNode->key) {
+            if (tail) {
+                tail->next = minNode;
+                batchMin->next = head;
+            } else {
+                batchMin->next = minNode;
+            }
+            minNode = batchMin;
+        } else {
+            batchMin->next = head;
+            if (!tail) tail = batchMin;
+            tail->next = minNode->next;
+            minNode->next = batchMin;
+        }
+        nNodes += count;
+        currentRootCount += (int)count;
+        maxHeapHeight = std::max(maxHeapHeight, 1);
+    }
+
     bool empty() const override {
         return minNode == nullptr;
     }
@@ -90,7 +132,6 @@ public:
             curr = nextNode;
         }
         
-        delete oldMin;
         nNodes--;
         minNode = nullptr;
         
@@ -109,58 +150,61 @@ public:
                     }
                     c = nextChild;
                 }
-                delete node; // Remove hollow node
+                // hollow node is dropped here; its memory stays with allNodes
             } else {
                 addToRankBuckets(rankBuckets, node);
             }
         }
         
-        // Rebuild heap from rank buckets
+        // Rebuild heap from rank buckets, refreshing the structural counters
+        // on the way instead of walking the root list afterwards
+        currentRootCount = 0;
+        maxHeapHeight = 0;
         for (auto* node : rankBuckets) {
             if (node != nullptr) {
                 minNode = meld(minNode, node);
+                currentRootCount++;
+                maxHeapHeight = std::max(maxHeapHeight, node->rank + 1);
             }
         }
         
-        updateHeapHeight();
-        updateRootCount();
         return res;
     }
 
     void decrease_key(PQNodeBase* n, double new_key) override {
         auto* node = dynamic_cast<HollowNode*>(n);
-        if (!node || node->isHollow) return;
-        if (new_key >= node->key) return;
+        if (!node) return;
 
         // The key insight: we need to find the ACTUAL active node for this value
-        // because the pointer 'n' might be stale
+        // because the pointer 'n' might be stale (hollowed by an earlier
+        // decrease_key). A value with no active node was already extracted.
         int targetValue = node->value;
         
         // Find the current active node for this value
         auto it = valueToNode.find(targetValue);
-        if (it != valueToNode.end()) {
-            node = it->second;
-        }
+        if (it == valueToNode.end()) return;
+        node = it->second;
         
-        if (node->isHollow) return; // Already hollow
+        if (new_key >= node->key) return;
         
         // Create new node with decreased key
-        auto* newNode = new HollowNode(new_key, node->value);
-        newNode->rank = node->rank;
-        newNode->child = node->child;
-        newNode->secondParent = node;
+        auto* fresh = newNode(new_key, node->value);
+        fresh->rank = node->rank;
+        fresh->child = node->child;
+        fresh->secondParent = node;
         
         // Mark old node as hollow
         node->isHollow = true;
         node->child = nullptr;
         
         // Update tracking to point to new node
-        valueToNode[node->value] = newNode;
+        valueToNode[node->value] = fresh;
         
         // Add new node to root list
-        minNode = meld(minNode, newNode);
+        minNode = meld(minNode, fresh);
         
-        updateHeapHeight();
+        currentRootCount++;
+        maxHeapHeight = std::max(maxHeapHeight, fresh->rank + 1);
     }
 
     void remove(PQNodeBase* n) override {
@@ -185,9 +229,9 @@ public:
     }
 
     double getMemoryUsageMBEstimate() const override {
-        // Count actual nodes (including hollow ones still in structure)
-        size_t totalNodes = nNodes + valueToNode.size(); 
-        double bytes = sizeof(HollowHeap) + totalNodes * sizeof(HollowNode);
+        // Every node ever allocated is still owned by the heap
+        double bytes = sizeof(HollowHeap) + allNodes.size() * sizeof(HollowNode)
+                     + allNodes.capacity() * sizeof(HollowNode*);
         return bytes / (1024.0 * 1024.0);
     }
 
@@ -196,46 +240,32 @@ private:
     size_t nNodes;
     int maxHeapHeight;
     int currentRootCount;
-    std::unordered_map<int, HollowNode*> valueToNode; // Track active node for each vertex
+    // Track active node for each vertex
+    std::unordered_map<int, HollowNode*, std::hash<int>, std::equal_to<int>,
+                       TrackingAllocator<std::pair<const int, HollowNode*>,
+                                         MemComponent::HeapStructure>> valueToNode;
 
-    void collectAllNodes(HollowNode* root, std::vector<HollowNode*>& nodes) {
-        if (!root) return;
-        
-        std::vector<HollowNode*> stack;
-        stack.push_back(root);
-        
-        std::unordered_map<HollowNode*, bool> visited;
-        
-        while (!stack.empty()) {
-            HollowNode* curr = stack.back();
-            stack.pop_back();
-            
-            if (visited[curr]) continue;
-            visited[curr] = true;
-            nodes.push_back(curr);
-            
-            // Add siblings
-            HollowNode* sibling = curr->next;
-            while (sibling && sibling != root && !visited[sibling]) {
-                stack.push_back(sibling);
-                sibling = sibling->next;
-            }
-            
-            // Add children
-            if (curr->child) {
-                stack.push_back(curr->child);
-            }
-        }
+    // Owns every node until the heap dies. Callers (runDijkstra) keep handles
+    // to nodes that have since become hollow or been extracted, and
+    // decrease_key still has to read them, so nodes are never freed early.
+    TrackedVector<HollowNode*, MemComponent::HeapStructure> allNodes;
+
+    HollowNode* newNode(double key, int value) {
+        auto* node = new HollowNode(key, value);
+        allNodes.push_back(node);
+        return node;
     }
 
     static HollowNode* meld(HollowNode* a, HollowNode* b) {
         if (!a) return b;
         if (!b) return a;
         
-        // Ensure 'a' has smaller key (will be the min)
-        if (b->key < a->key) std::swap(a, b);
-        
-        // Insert b into root list after a
+        // b is always a single detached root. If it is the new minimum it
+        // goes in front of the list, otherwise right after a.
+        if (b->key < a->key) {
+            b->next = a;
+            return b;
+        }
         b->next = a->next;
         a->next = b;
         
@@ -269,35 +299,6 @@ private:
         
         return a;
     }
-    
-    void updateHeapHeight() {
-        if (!minNode) {
-            maxHeapHeight = 0;
-            return;
-        }
-        
-        int maxRank = 0;
-        HollowNode* curr = minNode;
-        do {
-            maxRank = std::max(maxRank, curr->rank);
-            curr = curr->next;
-            if (!curr) break;
-        } while (curr != minNode);
-        
-        maxHeapHeight = maxRank + 1;
-    }
-    
-    void updateRootCount() {
-        currentRootCount = 0;
-        if (!minNode) return;
-        
-        HollowNode* curr = minNode;
-        do {
-            currentRootCount++;
-            curr = curr->next;
-            if (!curr) break;
-        } while (curr != minNode);
-    }
 };
 
 #endif // HOLLOW_HEAP_H
\ No newline at end of file
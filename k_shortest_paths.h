@@ -0,0 +1,260 @@
+// k_shortest_paths.h
+#ifndef K_SHORTEST_PATHS_H
+#define K_SHORTEST_PATHS_H
+
+#include <vector>
+#include <set>
+#include <limits>
+#include <chrono>
+#include <utility>
+#include <algorithm>
+#include "graph.h"
+#include "priority_queue.h"
+#include "dijkstra.h"
+
+struct WeightedPath {
+    std::vector<int> vertices;
+    double cost;
+};
+
+struct KspStats {
+    long long spurNodes = 0;      // deviation points considered
+    long long spurPruned = 0;     // skipped by the lower bound
+    long long spurShortcuts = 0;  // answered by the reverse tree, no search
+    long long spurSearches = 0;   // A* searches actually run
+};
+
+// k shortest loopless paths (Yen) with the usual practical speedups:
+//  - one reverse SSSP from the target gives exact distances-to-target h(v);
+//    it is kept while the target does not change
+//  - if the reverse-tree path from a spur node avoids every ban, it is the
+//    optimal spur path and no search is needed
+//  - otherwise an A* search guided by h runs on a shared workspace, and is
+//    cut off (or skipped) once its lower bound cannot beat the candidates
+//    already needed
+template <typename PQType>
+class KShortestPaths {
+public:
+    explicit KShortestPaths(const Graph& graph)
+        : g(graph), target(-1) {}
+
+    std::vector<WeightedPath> find(int source, int tgt, int k, DijkstraMetrics& metrics) {
+        stats = KspStats{};
+        std::vector<WeightedPath> A;
+        if (k <= 0) return A;
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        prepareTarget(tgt, metrics);
+        int n = g.numVertices();
+        if ((int)banned.size() != n) banned.assign(n, 0);
+
+        if (h[source] < inf()) {
+            A.push_back(treePath(source));
+        }
+
+        std::set<std::pair<double, std::vector<int>>> B;
+        std::set<std::vector<int>> seen;
+        if (!A.empty()) seen.insert(A[0].vertices);
+
+        while (!A.empty() && (int)A.size() < k) {
+            const std::vector<int> prev = A.back().vertices;
+            std::vector<double> prefix(prev.size(), 0.0);
+            for (size_t i = 1; i < prev.size(); ++i) {
+                prefix[i] = prefix[i - 1] + edgeWeight(prev[i - 1], prev[i]);
+            }
+
+            for (size_t i = 0; i + 1 < prev.size(); ++i) {
+                int spur = prev[i];
+                stats.spurNodes++;
+
+                // candidates we still need; anything not better than the
+                // worst of those cannot make it into the answer
+                double bound = inf();
+                size_t needed = (size_t)k - A.size();
+                if (B.size() >= needed) {
+                    auto it = B.begin();
+                    std::advance(it, needed - 1);
+                    bound = it->first;
+                }
+                if (prefix[i] + h[spur] >= bound) {
+                    stats.spurPruned++;
+                    continue;
+                }
+
+                // bans: root vertices, and next hops already used by paths
+                // that share this root
+                std::vector<int> bannedNext;
+                for (const auto& p : A) {
+                    if (p.vertices.size() > i + 1 &&
+                        std::equal(prev.begin(), prev.begin() + i + 1, p.vertices.begin())) {
+                        bannedNext.push_back(p.vertices[i + 1]);
+                    }
+                }
+                for (size_t j = 0; j < i; ++j) banned[prev[j]] = 1;
+
+                std::vector<int> spurPath;
+                double spurCost = inf();
+                if (treePathAllowed(spur, bannedNext)) {
+                    stats.spurShortcuts++;
+                    spurPath = treePath(spur).vertices;
+                    spurCost = h[spur];
+                } else {
+                    stats.spurSearches++;
+                    spurCost = searchSpur(spur, bannedNext, bound - prefix[i], spurPath, metrics);
+                }
+
+                for (size_t j = 0; j < i; ++j) banned[prev[j]] = 0;
+
+                if (spurPath.empty()) continue;
+                std::vector<int> full(prev.begin(), prev.begin() + i);
+                full.insert(full.end(), spurPath.begin(), spurPath.end());
+                if (seen.insert(full).second) {
+                    B.emplace(prefix[i] + spurCost, std::move(full));
+                }
+            }
+
+            if (B.empty()) break;
+            auto best = B.begin();
+            A.push_back({best->second, best->first});
+            B.erase(best);
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        metrics.runtimeMs =
+            std::chrono::duration<double, std::milli>(end - start).count();
+        return A;
+    }
+
+    const KspStats& getStats() const { return stats; }
+
+private:
+    const Graph& g;
+    int target;
+    unsigned long long targetVersion = 0;
+    std::vector<double> h;   // exact distance to target
+    std::vector<int> succ;   // next hop towards target in the reverse tree
+    std::vector<char> banned;
+    DijkstraWorkspace ws;
+    KspStats stats;
+
+    static double inf() { return std::numeric_limits<double>::infinity(); }
+
+    double edgeWeight(int u, int v) const {
+        double w = inf();
+        for (const auto& e : g.neighbors(u)) {
+            if (e.to == v && e.weight < w) w = e.weight;
+        }
+        return w;
+    }
+
+    // Reverse SSSP from the target over incoming edges.
+    void prepareTarget(int tgt, DijkstraMetrics& metrics) {
+        if (tgt == target && targetVersion == g.version() &&
+            (int)h.size() == g.numVertices()) return;
+        target = tgt;
+        targetVersion = g.version();
+        int n = g.numVertices();
+        h.assign(n, inf());
+        succ.assign(n, -1);
+        std::vector<PQNodeBase*> handles(n, nullptr);
+
+        PQType pq;
+        h[target] = 0.0;
+        handles[target] = pq.insert(0.0, target);
+        metrics.inserts++;
+        while (!pq.empty()) {
+            auto [d, u] = pq.extract_min();
+            metrics.extractMins++;
+            if (d > h[u]) continue;
+            for (const auto& e : g.inNeighbors(u)) {
+                int v = e.to;
+                double nd = d + e.weight;
+                if (nd < h[v]) {
+                    h[v] = nd;
+                    succ[v] = u;
+                    if (handles[v] == nullptr) {
+                        handles[v] = pq.insert(nd, v);
+                        metrics.inserts++;
+                    } else {
+                        pq.decrease_key(handles[v], nd);
+                        metrics.decreaseKeys++;
+                    }
+                }
+            }
+        }
+    }
+
+    WeightedPath treePath(int from) const {
+        WeightedPath p;
+        p.cost = h[from];
+        for (int v = from; v != -1; v = succ[v]) p.vertices.push_back(v);
+        return p;
+    }
+
+    bool treePathAllowed(int spur, const std::vector<int>& bannedNext) const {
+        if (spur == target) return true;
+        int next = succ[spur];
+        if (std::find(bannedNext.begin(), bannedNext.end(), next) != bannedNext.end())
+            return false;
+        for (int v = next; v != -1; v = succ[v]) {
+            if (banned[v]) return false;
+        }
+        return true;
+    }
+
+    // A* from spur to target with potential h, honouring the bans. Gives up
+    // once the best remaining estimate reaches costBound.
+    double searchSpur(int spur, const std::vector<int>& bannedNext, double costBound,
+                      std::vector<int>& pathOut, DijkstraMetrics& metrics) {
+        ws.prepare(g.numVertices());
+        auto& dist = ws.dist;
+        auto& parent = ws.parent;
+        auto& handles = ws.handles;
+
+        PQType pq;
+        dist[spur] = 0.0;
+        ws.touch(spur);
+        handles[spur] = pq.insert(h[spur], spur);
+        metrics.inserts++;
+
+        double found = inf();
+        while (!pq.empty()) {
+            auto [f, u] = pq.extract_min();
+            metrics.extractMins++;
+            if (f >= costBound) break;
+            if (f > dist[u] + h[u]) continue;
+            if (u == target) {
+                found = dist[u];
+                break;
+            }
+            for (const auto& e : g.neighbors(u)) {
+                int v = e.to;
+                if (banned[v] || h[v] == inf()) continue;
+                if (u == spur && std::find(bannedNext.begin(), bannedNext.end(), v)
+                                 != bannedNext.end()) continue;
+                double nd = dist[u] + e.weight;
+                if (nd < dist[v]) {
+                    dist[v] = nd;
+                    parent[v] = u;
+                    if (handles[v] == nullptr) {
+                        ws.touch(v);
+                        handles[v] = pq.insert(nd + h[v], v);
+                        metrics.inserts++;
+                    } else {
+                        pq.decrease_key(handles[v], nd + h[v]);
+                        metrics.decreaseKeys++;
+                    }
+                }
+            }
+        }
+
+        pathOut.clear();
+        if (found == inf()) return found;
+        for (int v = target; v != -1; v = (v == spur ? -1 : parent[v])) pathOut.push_back(v);
+        std::reverse(pathOut.begin(), pathOut.end());
+        return found;
+    }
+};
+
+#endif // K_SHORTEST_PATHS_H
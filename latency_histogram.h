@@ -0,0 +1,260 @@
+// latency_histogram.h
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <vector>
+#include <cstdint>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <iostream>
+#include "priority_queue.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Cheap timestamp in CPU ticks: rdtsc on x86, the virtual counter on
+// AArch64, steady_clock nanoseconds elsewhere. Two reads cost a few ns,
+// compared to ~50 ns for a pair of high_resolution_clock::now() calls.
+inline uint64_t readTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t v;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Tick rate and the cost of an empty readTicks() pair, measured once.
+struct TickCalibration {
+    double ticksPerNs = 1.0;
+    uint64_t overheadTicks = 0;
+
+    static const TickCalibration& get() {
+        static const TickCalibration cal = measure();
+        return cal;
+    }
+
+private:
+    static TickCalibration measure() {
+        TickCalibration c;
+        auto t0 = std::chrono::steady_clock::now();
+        uint64_t k0 = readTicks();
+        while (std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(20)) {}
+        uint64_t k1 = readTicks();
+        auto t1 = std::chrono::steady_clock::now();
+        double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        if (ns > 0 && k1 > k0) c.ticksPerNs = (double)(k1 - k0) / ns;
+
+        uint64_t best = std::numeric_limits<uint64_t>::max();
+        for (int i = 0; i < 1000; ++i) {
+            uint64_t a = readTicks();
+            uint64_t b = readTicks();
+            best = std::min(best, b - a);
+        }
+        c.overheadTicks = best;
+        return c;
+    }
+};
+
+// Log-linear histogram in the style of HdrHistogram: every power of two is
+// split into SubBuckets/2 linear buckets, so any recorded value is known to
+// within ~1.6% while the whole 64-bit range fits in a few thousand counters.
+// Recording is a shift, a count-leading-zeros and an increment.
+class LatencyHistogram {
+public:
+    static constexpr int SubBits = 7;
+    static constexpr uint64_t SubBuckets = 1ull << SubBits;
+    static constexpr int NumBuckets = (int)(SubBuckets + (64 - SubBits) * (SubBuckets / 2));
+
+    LatencyHistogram() : counts(NumBuckets, 0) { reset(); }
+
+    void reset() {
+        std::fill(counts.begin(), counts.end(), 0);
+        total = 0;
+        sum = 0;
+        minValue = std::numeric_limits<uint64_t>::max();
+        maxValue = 0;
+    }
+
+    void record(uint64_t v) {
+        counts[bucketOf(v)]++;
+        total++;
+        sum += v;
+        if (v < minValue) minValue = v;
+        if (v > maxValue) maxValue = v;
+    }
+
+    void merge(const LatencyHistogram& o) {
+        for (int i = 0; i < NumBuckets; ++i) counts[i] += o.counts[i];
+        total += o.total;
+        sum += o.sum;
+        minValue = std::min(minValue, o.minValue);
+        maxValue = std::max(maxValue, o.maxValue);
+    }
+
+    uint64_t count() const { return total; }
+    uint64_t min() const { return total ? minValue : 0; }
+    uint64_t max() const { return maxValue; }
+    double mean() const { return total ? (double)sum / (double)total : 0.0; }
+
+    // Smallest value v such that at least p (0..1) of the samples are <= v,
+    // reported as the upper edge of its bucket (capped at the exact max).
+    uint64_t percentile(double p) const {
+        if (total == 0) return 0;
+        uint64_t rank = (uint64_t)(p * (double)total + 0.5);
+        if (rank < 1) rank = 1;
+        if (rank > total) rank = total;
+        uint64_t seen = 0;
+        for (int i = 0; i < NumBuckets; ++i) {
+            seen += counts[i];
+            if (seen >= rank) return std::min(bucketHigh(i), maxValue);
+        }
+        return maxValue;
+    }
+
+    int numBuckets() const { return NumBuckets; }
+    uint64_t bucketCount(int i) const { return counts[i]; }
+
+    static int bucketOf(uint64_t v) {
+        if (v < SubBuckets) return (int)v;
+        int msb = 63 - __builtin_clzll(v);
+        int shift = msb - (SubBits - 1);
+        uint64_t mantissa = v >> shift; // in [SubBuckets/2, SubBuckets)
+        return (int)(SubBuckets + (uint64_t)(shift - 1) * (SubBuckets / 2)
+                     + (mantissa - SubBuckets / 2));
+    }
+
+    static uint64_t bucketLow(int i) {
+        if ((uint64_t)i < SubBuckets) return (uint64_t)i;
+        uint64_t j = (uint64_t)i - SubBuckets;
+        int shift = (int)(j / (SubBuckets / 2)) + 1;
+        uint64_t mantissa = j % (SubBuckets / 2) + SubBuckets / 2;
+        return mantissa << shift;
+    }
+
+    static uint64_t bucketHigh(int i) {
+        if ((uint64_t)i < SubBuckets) return (uint64_t)i;
+        uint64_t j = (uint64_t)i - SubBuckets;
+        int shift = (int)(j / (SubBuckets / 2)) + 1;
+        return bucketLow(i) + ((1ull << shift) - 1);
+    }
+
+private:
+    std::vector<uint64_t> counts;
+    uint64_t total;
+    uint64_t sum;
+    uint64_t minValue;
+    uint64_t maxValue;
+};
+
+// One histogram per operation class, in ticks (overhead already removed).
+struct LatencyProfile {
+    LatencyHistogram insert;
+    LatencyHistogram extractMin;
+    LatencyHistogram decreaseKey;
+
+    void reset() {
+        insert.reset();
+        extractMin.reset();
+        decreaseKey.reset();
+    }
+
+    // Where default-constructed InstrumentedPQs record, one per thread, so
+    // runDijkstra<InstrumentedPQ<...>> needs no extra plumbing.
+    static LatencyProfile& threadDefault() {
+        static thread_local LatencyProfile profile;
+        return profile;
+    }
+};
+
+// Wraps any PriorityQueue and times every insert / extract_min /
+// decrease_key into a LatencyProfile. Drop-in for runDijkstra:
+//   LatencyProfile::threadDefault().reset();
+//   runDijkstra<InstrumentedPQ<FibonacciHeap>>(g, 0, metrics);
+template <typename PQType>
+class InstrumentedPQ : public PriorityQueue {
+public:
+    InstrumentedPQ()
+        : profile(LatencyProfile::threadDefault()),
+          overhead(TickCalibration::get().overheadTicks) {}
+    explicit InstrumentedPQ(LatencyProfile& p)
+        : profile(p), overhead(TickCalibration::get().overheadTicks) {}
+
+    PQNodeBase* insert(double key, int value) override {
+        uint64_t t0 = readTicks();
+        PQNodeBase* n = inner.insert(key, value);
+        uint64_t t1 = readTicks();
+        profile.insert.record(elapsed(t0, t1));
+        return n;
+    }
+
+    bool empty() const override { return inner.empty(); }
+    std::pair<double,int> find_min() const override { return inner.find_min(); }
+
+    std::pair<double,int> extract_min() override {
+        uint64_t t0 = readTicks();
+        auto res = inner.extract_min();
+        uint64_t t1 = readTicks();
+        profile.extractMin.record(elapsed(t0, t1));
+        return res;
+    }
+
+    void decrease_key(PQNodeBase* node, double new_key) override {
+        uint64_t t0 = readTicks();
+        inner.decrease_key(node, new_key);
+        uint64_t t1 = readTicks();
+        profile.decreaseKey.record(elapsed(t0, t1));
+    }
+
+    void remove(PQNodeBase* node) override { inner.remove(node); }
+
+    int getSize() const override { return inner.getSize(); }
+    int getHeightEstimate() const override { return inner.getHeightEstimate(); }
+    int getNumTrees() const override { return inner.getNumTrees(); }
+    long long getNumCascadingCuts() const override { return inner.getNumCascadingCuts(); }
+    double getMemoryUsageMBEstimate() const override { return inner.getMemoryUsageMBEstimate(); }
+
+    PQType& underlying() { return inner; }
+
+private:
+    PQType inner;
+    LatencyProfile& profile;
+    uint64_t overhead;
+
+    uint64_t elapsed(uint64_t t0, uint64_t t1) const {
+        uint64_t d = t1 > t0 ? t1 - t0 : 0;
+        return d > overhead ? d - overhead : 0;
+    }
+};
+
+inline double ticksToNs(uint64_t ticks) {
+    return (double)ticks / TickCalibration::get().ticksPerNs;
+}
+
+// summary: op,count,mean_ns,p50_ns,p90_ns,p99_ns,p999_ns,p9999_ns,max_ns
+inline void writeLatencySummaryRow(std::ostream& out, const char* op,
+                                   const LatencyHistogram& h) {
+    out << op << "," << h.count() << "," << ticksToNs((uint64_t)h.mean()) << ","
+        << ticksToNs(h.percentile(0.50)) << "," << ticksToNs(h.percentile(0.90)) << ","
+        << ticksToNs(h.percentile(0.99)) << "," << ticksToNs(h.percentile(0.999)) << ","
+        << ticksToNs(h.percentile(0.9999)) << "," << ticksToNs(h.max()) << "\n";
+}
+
+// full distribution: op,bucket_low_ns,bucket_high_ns,count (non-empty buckets)
+inline void writeLatencyDistribution(std::ostream& out, const char* op,
+                                     const LatencyHistogram& h) {
+    for (int i = 0; i < h.numBuckets(); ++i) {
+        if (h.bucketCount(i) == 0) continue;
+        out << op << "," << ticksToNs(LatencyHistogram::bucketLow(i)) << ","
+            << ticksToNs(LatencyHistogram::bucketHigh(i)) << ","
+            << h.bucketCount(i) << "\n";
+    }
+}
+
+#endif // LATENCY_HISTOGRAM_H
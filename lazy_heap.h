@@ -0,0 +1,98 @@
+// lazy_heap.h
+#ifndef LAZY_HEAP_H
+#define LAZY_HEAP_H
+
+#include <vector>
+#include <cstddef>
+#include <limits>
+#include "memory_tracker.h"
+
+// Addressable-free d-ary min-heap of inline (key, value) pairs, for
+// Dijkstra with lazy deletion: instead of decrease_key the search pushes a
+// second entry and skips the stale one when it is popped (runDijkstraLazy).
+// There are no nodes, no handles and no position index to keep up to date,
+// so every sift step moves 16 bytes within one array. With Arity = 4 the
+// tree is half as deep as a binary heap, and the four children of a node
+// share one 64-byte cache line: the array is 64-byte aligned and the root
+// sits at slot Arity - 1, so the children of slot j, Arity * (j - Arity + 2)
+// onwards, start on a line boundary (for any Arity whose sibling group is a
+// divisor or multiple of 64 bytes).
+//
+// This is deliberately not a PriorityQueue: it cannot support
+// decrease_key or remove.
+template <int Arity = 4>
+class LazyDAryHeap {
+    static_assert(Arity >= 2, "a d-ary heap needs at least two children per node");
+
+public:
+    struct Entry {
+        double key;
+        int value;
+    };
+
+    LazyDAryHeap() : heap(Root) {}
+
+    bool empty() const { return heap.size() == Root; }
+    size_t size() const { return heap.size() - Root; }
+    void clear() { heap.resize(Root); }
+    void reserve(size_t n) { heap.reserve(n + Root); }
+
+    const Entry& top() const { return heap[Root]; }
+
+    void push(double key, int value) {
+        heap.push_back({key, value});
+        siftUp(heap.size() - 1);
+    }
+
+    Entry pop() {
+        Entry res = heap[Root];
+        Entry last = heap.back();
+        heap.pop_back();
+        if (!empty()) siftDown(Root, last);
+        return res;
+    }
+
+    double getMemoryUsageMBEstimate() const {
+        return (sizeof(*this) + heap.capacity() * sizeof(Entry)) / (1024.0 * 1024.0);
+    }
+
+private:
+    // Slots 0 .. Root - 1 are padding that puts sibling groups on lines.
+    static constexpr size_t Root = Arity - 1;
+
+    std::vector<Entry, TrackingAllocator<Entry, MemComponent::HeapStructure, 64>> heap;
+
+    // Hole-based sifts: shift entries and write the moving one once.
+    void siftUp(size_t i) {
+        Entry e = heap[i];
+        while (i > Root) {
+            size_t p = (i - Root - 1) / Arity + Root;
+            if (!(e.key < heap[p].key)) break;
+            heap[i] = heap[p];
+            i = p;
+        }
+        heap[i] = e;
+    }
+
+    void siftDown(size_t i, Entry e) {
+        size_t n = heap.size();
+        while (true) {
+            size_t first = (i - Root + 1) * Arity;
+            if (first >= n) break;
+            size_t last = first + Arity < n ? first + Arity : n;
+            size_t best = first;
+            for (size_t c = first + 1; c < last; ++c) {
+                if (heap[c].key < heap[best].key) best = c;
+            }
+            if (!(heap[best].key < e.key)) break;
+            heap[i] = heap[best];
+            i = best;
+        }
+        heap[i] = e;
+    }
+};
+
+using LazyBinaryHeap = LazyDAryHeap<2>;
+using LazyQuaternaryHeap = LazyDAryHeap<4>;
+
+#endif // LAZY_HEAP_H
@@ -0,0 +1,229 @@
+// memory_tracker.h
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+
+// Byte-exact memory accounting per component. Containers opt in through
+// TrackingAllocator; heap nodes are counted by PQNodeBase's operator new.
+//
+// Every thread counts into its own cache-line aligned shard, so the parallel
+// engines do not all hit one shared counter on each insert and extract. The
+// shards are summed when read: live bytes and the counts are exact totals.
+// The peak is the sum of every thread's own peak. That is exact for a
+// single-threaded run and an upper bound when several threads allocate at
+// once. A thread's shard is reused by a later thread after it exits.
+//
+// Build with -DPQ_NO_MEMORY_TRACKING to compile the counting out entirely.
+
+enum class MemComponent {
+    Graph,          // adjacency lists
+    Dijkstra,       // dist / parent / handle buffers and workspaces
+    HeapNodes,      // PQNodeBase-derived nodes
+    HeapStructure,  // heap arrays, lookup maps, node arenas
+    Count
+};
+
+inline const char* memComponentName(MemComponent c) {
+    switch (c) {
+        case MemComponent::Graph:         return "graph";
+        case MemComponent::Dijkstra:      return "dijkstra";
+        case MemComponent::HeapNodes:     return "heap_nodes";
+        case MemComponent::HeapStructure: return "heap_structure";
+        default:                          return "unknown";
+    }
+}
+
+constexpr int kNumMemComponents = (int)MemComponent::Count;
+
+// Counters of one thread. Only the owning thread writes them, apart from
+// resetMemoryPeaks(), so a load and a store replace the atomic
+// read-modify-writes; the atomics only make reads from other threads well
+// defined.
+struct alignas(64) MemoryShard {
+    struct Counters {
+        std::atomic<long long> liveBytes{0};
+        std::atomic<long long> peakBytes{0};
+        std::atomic<long long> allocations{0};
+        std::atomic<long long> deallocations{0};
+    };
+    Counters c[kNumMemComponents];
+    bool inUse = false;
+
+    static void bump(std::atomic<long long>& a, long long by) {
+        a.store(a.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    void onAllocate(MemComponent comp, size_t bytes) {
+        Counters& k = c[(int)comp];
+        long long live = k.liveBytes.load(std::memory_order_relaxed) + (long long)bytes;
+        k.liveBytes.store(live, std::memory_order_relaxed);
+        if (live > k.peakBytes.load(std::memory_order_relaxed))
+            k.peakBytes.store(live, std::memory_order_relaxed);
+        bump(k.allocations, 1);
+    }
+
+    // Memory freed by another thread than the one that allocated it makes
+    // this shard's live count negative; only the sum is meaningful.
+    void onDeallocate(MemComponent comp, size_t bytes) {
+        Counters& k = c[(int)comp];
+        bump(k.liveBytes, -(long long)bytes);
+        bump(k.deallocations, 1);
+    }
+};
+
+// All shards ever created. They are never freed, since memory may still be
+// released through a shard after its thread has exited.
+class MemoryShardRegistry {
+public:
+    static MemoryShardRegistry& instance() {
+        static MemoryShardRegistry* r = new MemoryShardRegistry();
+        return *r;
+    }
+
+    MemoryShard* acquire() {
+        std::lock_guard<std::mutex> lk(mtx);
+        for (MemoryShard* s : shards) {
+            if (!s->inUse) {
+                s->inUse = true;
+                return s;
+            }
+        }
+        shards.push_back(new MemoryShard());
+        shards.back()->inUse = true;
+        return shards.back();
+    }
+
+    void release(MemoryShard* s) {
+        std::lock_guard<std::mutex> lk(mtx);
+        s->inUse = false;
+    }
+
+    template <typename Fn>
+    void forEach(Fn fn) {
+        std::lock_guard<std::mutex> lk(mtx);
+        for (MemoryShard* s : shards) fn(*s);
+    }
+
+private:
+    std::mutex mtx;
+    std::vector<MemoryShard*> shards;
+};
+
+inline MemoryShard& localMemoryShard() {
+    struct Handle {
+        MemoryShard* shard = MemoryShardRegistry::instance().acquire();
+        ~Handle() { MemoryShardRegistry::instance().release(shard); }
+    };
+    thread_local Handle h;
+    return *h.shard;
+}
+
+// align = 0 means the default operator new alignment.
+inline void* trackedAllocate(MemComponent c, size_t bytes, size_t align = 0) {
+    void* p = align ? ::operator new(bytes, std::align_val_t(align)) : ::operator new(bytes);
+#ifndef PQ_NO_MEMORY_TRACKING
+    localMemoryShard().onAllocate(c, bytes);
+#else
+    (void)c;
+#endif
+    return p;
+}
+
+inline void trackedDeallocate(MemComponent c, void* p, size_t bytes, size_t align = 0) {
+#ifndef PQ_NO_MEMORY_TRACKING
+    localMemoryShard().onDeallocate(c, bytes);
+#else
+    (void)c;
+    (void)bytes;
+#endif
+    if (align) ::operator delete(p, std::align_val_t(align));
+    else ::operator delete(p);
+}
+
+// Standard allocator that charges every byte to component C. Align > 0
+// aligns every block to that many bytes (e.g. 64 for a cache line).
+template <typename T, MemComponent C, size_t Align = 0>
+struct TrackingAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = TrackingAllocator<U, C, Align>; };
+
+    TrackingAllocator() noexcept = default;
+    template <typename U>
+    TrackingAllocator(const TrackingAllocator<U, C, Align>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(trackedAllocate(C, n * sizeof(T), Align));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        trackedDeallocate(C, p, n * sizeof(T), Align);
+    }
+
+    template <typename U>
+    bool operator==(const TrackingAllocator<U, C, Align>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const TrackingAllocator<U, C, Align>&) const noexcept { return false; }
+};
+
+template <typename T, MemComponent C>
+using TrackedVector = std::vector<T, TrackingAllocator<T, C>>;
+
+// Plain copy of the counters, for reporting.
+struct MemoryUsage {
+    long long liveBytes = 0;
+    long long peakBytes = 0;
+    long long allocations = 0;
+    long long deallocations = 0;
+};
+
+inline MemoryUsage memoryUsage(MemComponent c) {
+    MemoryUsage u;
+    MemoryShardRegistry::instance().forEach([&](const MemoryShard& s) {
+        const MemoryShard::Counters& k = s.c[(int)c];
+        u.liveBytes += k.liveBytes.load(std::memory_order_relaxed);
+        u.peakBytes += k.peakBytes.load(std::memory_order_relaxed);
+        u.allocations += k.allocations.load(std::memory_order_relaxed);
+        u.deallocations += k.deallocations.load(std::memory_order_relaxed);
+    });
+    return u;
+}
+
+// Restart peak tracking from the current live size, e.g. right before the
+// run you want to measure.
+inline void resetMemoryPeaks() {
+    MemoryShardRegistry::instance().forEach([](MemoryShard& s) {
+        for (auto& k : s.c) {
+            k.peakBytes.store(k.liveBytes.load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+        }
+    });
+}
+
+inline double bytesToMB(long long bytes) {
+    return (double)bytes / (1024.0 * 1024.0);
+}
+
+// component,live_mb,peak_mb,allocations,deallocations
+inline void printMemoryReport(std::ostream& out) {
+    out << "component,live_mb,peak_mb,allocations,deallocations\n";
+    for (int i = 0; i < kNumMemComponents; ++i) {
+        MemoryUsage u = memoryUsage((MemComponent)i);
+        out << memComponentName((MemComponent)i) << ","
+            << std::fixed << std::setprecision(4)
+            << bytesToMB(u.liveBytes) << "," << bytesToMB(u.peakBytes) << ","
+            << std::defaultfloat
+            << u.allocations << "," << u.deallocations << "\n";
+    }
+}
+
+#endif // MEMORY_TRACKER_H
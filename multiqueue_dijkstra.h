@@ -0,0 +1,176 @@
+// multiqueue_dijkstra.h
+#ifndef MULTIQUEUE_DIJKSTRA_H
+#define MULTIQUEUE_DIJKSTRA_H
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+#include "graph.h"
+#include "dijkstra.h"
+#include "concurrent_sssp.h"
+#include "priority_queue.h"
+#include "lazy_heap.h"
+#include "graph_generators.h"
+
+// Shared-frontier parallel SSSP on a MultiQueue (Rihani, Sanders &
+// Dementiev, 2015), driven by runConcurrentSSSP (concurrent_sssp.h).
+// Unlike runDijkstraMultiSource, which gives every thread its own source,
+// all threads cooperate on one search:
+//
+//   queues   c * p sequential heaps, each behind a mutex that is only
+//            ever try-locked, with its current minimum cached in an atomic
+//   push     into a random queue (another one if the lock is taken)
+//   pop      peek the cached minima of two random queues and pop from the
+//            smaller one
+//
+// HeapType can be a lazy heap (LazyDAryHeap, SequenceHeap) or any
+// PriorityQueue; decrease_key is never used, handles are dropped.
+
+struct MultiQueueStats {
+    long long stalePops = 0;     // popped entries already beaten by dist[u]
+    long long lockFailures = 0;  // try_lock that found the queue busy
+    long long casFailures = 0;   // CAS retries on dist[]
+    long long emptyPolls = 0;    // pops that found nothing while work was pending
+};
+
+namespace mq_detail {
+
+template <typename H>
+void push(H& h, double key, int value) {
+    if constexpr (std::is_base_of<PriorityQueue, H>::value) h.insert(key, value);
+    else h.push(key, value);
+}
+
+template <typename H>
+std::pair<double,int> pop(H& h) {
+    if constexpr (std::is_base_of<PriorityQueue, H>::value) {
+        return h.extract_min();
+    } else {
+        auto e = h.pop();
+        return {e.key, e.value};
+    }
+}
+
+template <typename H>
+double topKey(H& h) {
+    if (h.empty()) return std::numeric_limits<double>::infinity();
+    if constexpr (std::is_base_of<PriorityQueue, H>::value) return h.find_min().first;
+    else return h.top().key;
+}
+
+} // namespace mq_detail
+
+template <typename HeapType>
+class MultiQueue {
+public:
+    struct alignas(64) Context {
+        SplitMix64 rng;
+        long long lockFailures = 0;
+    };
+
+    explicit MultiQueue(int numQueues, uint64_t seed = 1)
+        : n(numQueues < 1 ? 1 : numQueues), seed(seed), queues(new Queue[n]) {}
+
+    int numQueues() const { return n; }
+
+    Context makeContext(int tid) const {
+        Context ctx;
+        ctx.rng = SplitMix64(SplitMix64::mix(seed + 1 + tid));
+        return ctx;
+    }
+
+    void push(double key, int value, Context& ctx) {
+        while (true) {
+            Queue& q = queues[ctx.rng.below(n)];
+            if (!q.lock.try_lock()) {
+                ++ctx.lockFailures;
+                continue;
+            }
+            mq_detail::push(q.heap, key, value);
+            q.top.store(mq_detail::topKey(q.heap), std::memory_order_release);
+            q.lock.unlock();
+            return;
+        }
+    }
+
+    // Two-choice pop. Returns false if both sampled queues (or, after a few
+    // misses, all queues) looked empty.
+    bool tryPop(std::pair<double,int>& out, Context& ctx) {
+        const double inf = std::numeric_limits<double>::infinity();
+        for (int attempt = 0; attempt < 4; ++attempt) {
+            int i = (int)ctx.rng.below(n);
+            int j = (int)ctx.rng.below(n);
+            double ki = queues[i].top.load(std::memory_order_acquire);
+            double kj = queues[j].top.load(std::memory_order_acquire);
+            int pick = kj < ki ? j : i;
+            if ((kj < ki ? kj : ki) == inf) continue;
+            if (popFrom(pick, out, ctx)) return true;
+        }
+        // Few entries left: fall back to a scan so the tail of the search
+        // does not depend on lucky samples.
+        for (int i = 0; i < n; ++i) {
+            if (queues[i].top.load(std::memory_order_acquire) != inf && popFrom(i, out, ctx)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct alignas(64) Queue {
+        std::mutex lock;
+        std::atomic<double> top{std::numeric_limits<double>::infinity()};
+        HeapType heap;
+    };
+
+    int n;
+    uint64_t seed;
+    std::unique_ptr<Queue[]> queues;
+
+    bool popFrom(int i, std::pair<double,int>& out, Context& ctx) {
+        Queue& q = queues[i];
+        if (!q.lock.try_lock()) {
+            ++ctx.lockFailures;
+            return false;
+        }
+        bool ok = !q.heap.empty();
+        if (ok) {
+            out = mq_detail::pop(q.heap);
+            q.top.store(mq_detail::topKey(q.heap), std::memory_order_release);
+        }
+        q.lock.unlock();
+        return ok;
+    }
+};
+
+// queuesPerThread is the c in c * p.
+template <typename HeapType = LazyBinaryHeap>
+DijkstraResult runDijkstraMultiQueue(const Graph& g, int source, int numThreads,
+                                     DijkstraMetrics& metrics,
+                                     MultiQueueStats* statsOut = nullptr,
+                                     int queuesPerThread = 2, uint64_t seed = 1) {
+    if (numThreads <= 0) numThreads = 1;
+    if (queuesPerThread <= 0) queuesPerThread = 1;
+
+    MultiQueue<HeapType> mq(numThreads * queuesPerThread, seed);
+    std::vector<typename MultiQueue<HeapType>::Context> contexts;
+    ConcurrentSearchStats search;
+    DijkstraResult res = runConcurrentSSSP(g, source, numThreads, mq, contexts, metrics, search);
+
+    if (statsOut) {
+        MultiQueueStats total;
+        total.stalePops = search.stalePops;
+        total.casFailures = search.distCasFailures;
+        total.emptyPolls = search.emptyPolls;
+        for (const auto& ctx : contexts) total.lockFailures += ctx.lockFailures;
+        *statsOut = total;
+    }
+    return res;
+}
+
+#endif // MULTIQUEUE_DIJKSTRA_H
@@ -0,0 +1,83 @@
+// node_pool.h
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <vector>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include "memory_tracker.h"
+
+// Chunked arena for heap nodes. Nodes are carved out of geometrically
+// growing chunks with a pointer bump and are only destroyed together with
+// the pool, which matches how the drivers use handles: runDijkstra keeps the
+// handle of every vertex it ever inserted, extracted or not, so a node must
+// stay readable until the heap itself goes away. No per-node malloc, no
+// free-list reuse that could turn a stale handle into someone else's node.
+// Chunks are charged to MemComponent::HeapNodes.
+template <typename NodeT>
+class NodePool {
+public:
+    NodePool() = default;
+
+    ~NodePool() {
+        clear();
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    template <typename... Args>
+    NodeT* create(Args&&... args) {
+        if (used == capacity) grow();
+        void* slot = chunks.back().first + used * sizeof(NodeT);
+        ++used;
+        ++count;
+        // global placement new: PQNodeBase's class operator new would
+        // otherwise hide it
+        return ::new (slot) NodeT(std::forward<Args>(args)...);
+    }
+
+    // Destroys every node and releases all chunks.
+    void clear() {
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            size_t n = (c + 1 == chunks.size()) ? used : chunks[c].second;
+            for (size_t i = 0; i < n; ++i) {
+                reinterpret_cast<NodeT*>(chunks[c].first + i * sizeof(NodeT))->~NodeT();
+            }
+            trackedDeallocate(MemComponent::HeapNodes, chunks[c].first,
+                              chunks[c].second * sizeof(NodeT));
+        }
+        chunks.clear();
+        used = capacity = 0;
+        count = 0;
+        bytes = 0;
+    }
+
+    size_t size() const { return count; }
+    size_t bytesReserved() const { return bytes; }
+
+private:
+    static constexpr size_t FirstChunk = 256;
+    static constexpr size_t MaxChunk = 1 << 16;
+
+    std::vector<std::pair<char*, size_t>> chunks; // storage, node capacity
+    size_t used = 0;      // nodes used in the last chunk
+    size_t capacity = 0;  // node capacity of the last chunk
+    size_t count = 0;
+    size_t bytes = 0;
+
+    void grow() {
+        size_t n = chunks.empty() ? FirstChunk : std::min(capacity * 2, MaxChunk);
+        static_assert(alignof(NodeT) <= alignof(std::max_align_t),
+                      "NodePool needs operator new alignment");
+        char* mem = static_cast<char*>(trackedAllocate(MemComponent::HeapNodes, n * sizeof(NodeT)));
+        chunks.emplace_back(mem, n);
+        used = 0;
+        capacity = n;
+        bytes += n * sizeof(NodeT);
+    }
+};
+
+#endif // NODE_POOL_H
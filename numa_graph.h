@@ -0,0 +1,251 @@
+// numa_graph.h
+#ifndef NUMA_GRAPH_H
+#define NUMA_GRAPH_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include "graph.h"
+#include "dijkstra.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// NUMA-aware graph replication for multi-source batches, without libnuma.
+//
+// NumaTopology reads the node -> CPU map from /sys/devices/system/node, or
+// splits the usable CPUs into a given number of simulated nodes so the code
+// path can be exercised on a single-socket machine. ReplicatedGraph copies
+// the Graph once per node from a thread pinned to that node, so first-touch
+// placement puts each replica's adjacency lists in that node's memory.
+// runDijkstraMultiSourceNuma then pins every worker to a node and has it
+// search its local replica.
+//
+// Pinning uses pthread_setaffinity_np and is a no-op off Linux.
+
+struct NumaNode {
+    int id;
+    std::vector<int> cpus;
+};
+
+// Parses a sysfs CPU or node list such as "0-3,8-11".
+inline std::vector<int> parseCpuList(const std::string& s) {
+    std::vector<int> cpus;
+    std::stringstream ss(s);
+    std::string part;
+    while (std::getline(ss, part, ',')) {
+        if (part.empty()) continue;
+        size_t dash = part.find('-');
+        try {
+            if (dash == std::string::npos) {
+                cpus.push_back(std::stoi(part));
+            } else {
+                int lo = std::stoi(part.substr(0, dash));
+                int hi = std::stoi(part.substr(dash + 1));
+                for (int c = lo; c <= hi; ++c) cpus.push_back(c);
+            }
+        } catch (const std::exception&) {
+            // malformed entry: ignore it
+        }
+    }
+    return cpus;
+}
+
+// CPUs this process may run on.
+inline std::vector<int> usableCpus() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int c = 0; c < CPU_SETSIZE; ++c) {
+            if (CPU_ISSET(c, &set)) cpus.push_back(c);
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        int n = (int)std::max(1u, std::thread::hardware_concurrency());
+        for (int c = 0; c < n; ++c) cpus.push_back(c);
+    }
+    return cpus;
+}
+
+// Restricts the calling thread to cpus. Returns false if that is not
+// supported or the call fails; the thread then keeps running unpinned.
+inline bool pinCurrentThread(const std::vector<int>& cpus) {
+#ifdef __linux__
+    if (cpus.empty()) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c : cpus) {
+        if (c >= 0 && c < CPU_SETSIZE) CPU_SET(c, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+class NumaTopology {
+public:
+    // Nodes from /sys/devices/system/node, restricted to usable CPUs; one
+    // node holding every usable CPU if there is no such information.
+    static NumaTopology detect() {
+        NumaTopology t;
+        std::vector<int> usable = usableCpus();
+        std::ifstream online("/sys/devices/system/node/online");
+        std::string ids;
+        if (online.is_open()) std::getline(online, ids);
+        for (int node : parseCpuList(ids)) {
+            std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            std::string line;
+            if (!in.is_open() || !std::getline(in, line)) continue;
+            NumaNode n{node, {}};
+            for (int c : parseCpuList(line)) {
+                if (std::find(usable.begin(), usable.end(), c) != usable.end()) n.cpus.push_back(c);
+            }
+            if (!n.cpus.empty()) t.nodeList.push_back(n);
+        }
+        if (t.nodeList.empty()) t.nodeList.push_back({0, usable});
+        return t;
+    }
+
+    // numNodes simulated nodes over the usable CPUs, in contiguous blocks.
+    // With fewer CPUs than nodes, nodes share CPUs.
+    static NumaTopology simulate(int numNodes) {
+        NumaTopology t;
+        t.isSimulated = true;
+        if (numNodes < 1) numNodes = 1;
+        std::vector<int> usable = usableCpus();
+        int c = (int)usable.size();
+        for (int i = 0; i < numNodes; ++i) {
+            NumaNode n{i, {}};
+            for (int k = i * c / numNodes; k < (i + 1) * c / numNodes; ++k) n.cpus.push_back(usable[k]);
+            if (n.cpus.empty()) n.cpus.push_back(usable[i % c]);
+            t.nodeList.push_back(n);
+        }
+        return t;
+    }
+
+    int numNodes() const { return (int)nodeList.size(); }
+    const NumaNode& node(int i) const { return nodeList[i]; }
+    bool simulated() const { return isSimulated; }
+
+private:
+    std::vector<NumaNode> nodeList;
+    bool isSimulated = false;
+};
+
+// One Graph copy per NUMA node, each built by a thread pinned to its node.
+// Costs numNodes() times the graph's memory (charged to MemComponent::Graph).
+class ReplicatedGraph {
+public:
+    ReplicatedGraph(const Graph& g, const NumaTopology& topology)
+        : topo(topology), replicas(topology.numNodes()) {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < topo.numNodes(); ++i) {
+            threads.emplace_back([this, &g, i]() {
+                pinCurrentThread(topo.node(i).cpus);
+                replicas[i].reset(new Graph(g));
+            });
+        }
+        for (auto& th : threads) th.join();
+    }
+
+    int numReplicas() const { return (int)replicas.size(); }
+    const Graph& replica(int node) const { return *replicas[node]; }
+    const NumaTopology& topology() const { return topo; }
+
+private:
+    NumaTopology topo;
+    std::vector<std::unique_ptr<Graph>> replicas;
+};
+
+struct NumaRunStats {
+    std::vector<int> sourcesPerNode; // searches run on each node's replica
+    long long stolenSources = 0;     // taken from another node's batch
+    int pinnedThreads = 0;           // workers whose affinity call succeeded
+};
+
+// Same contract as runDijkstraMultiSource (parallel_dijkstra.h), but
+// thread t runs on node t % numNodes against that node's replica. sources
+// is cut into one contiguous batch per node; a worker drains its own node's
+// batch first, then helps with the others (still reading its local
+// replica, since the copies are identical).
+template <typename PQType>
+void runDijkstraMultiSourceNuma(
+    const ReplicatedGraph& rg,
+    const std::vector<int>& sources,
+    int numThreads,
+    std::vector<DijkstraMetrics>& metricsOut,
+    double& totalRuntimeMs,
+    NumaRunStats* statsOut = nullptr
+) {
+    if (numThreads <= 0) numThreads = 1;
+    int k = rg.numReplicas();
+    if (metricsOut.size() != sources.size()) {
+        metricsOut.assign(sources.size(), DijkstraMetrics{});
+    }
+
+    std::vector<size_t> batchBegin(k + 1);
+    for (int i = 0; i <= k; ++i) batchBegin[i] = sources.size() * i / k;
+    std::unique_ptr<std::atomic<size_t>[]> cursor(new std::atomic<size_t>[k]);
+    for (int i = 0; i < k; ++i) cursor[i].store(batchBegin[i]);
+
+    std::vector<int> perNode(k, 0);
+    std::vector<long long> stolen(numThreads, 0);
+    std::vector<int> ranOn(sources.size(), -1);
+    std::atomic<int> pinned{0};
+
+    auto worker = [&](int tid) {
+        int node = tid % k;
+        if (pinCurrentThread(rg.topology().node(node).cpus)) pinned++;
+        const Graph& local = rg.replica(node);
+        for (int step = 0; step < k; ++step) {
+            int batch = (node + step) % k;
+            while (true) {
+                size_t i = cursor[batch].fetch_add(1);
+                if (i >= batchBegin[batch + 1]) break;
+                runDijkstra<PQType>(local, sources[i], metricsOut[i]);
+                ranOn[i] = node;
+                if (batch != node) stolen[tid]++;
+            }
+        }
+    };
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    auto t2 = std::chrono::high_resolution_clock::now();
+    totalRuntimeMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+
+    if (statsOut) {
+        for (int node : ranOn) {
+            if (node >= 0) perNode[node]++;
+        }
+        statsOut->sourcesPerNode = perNode;
+        statsOut->stolenSources = 0;
+        for (long long s : stolen) statsOut->stolenSources += s;
+        statsOut->pinnedThreads = pinned.load();
+    }
+}
+
+#endif // NUMA_GRAPH_H
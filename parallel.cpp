@@ -9,16 +9,23 @@
 #include "dijkstra.h"
 #include "binary_heap.h"
 #include "parallel_dijkstra.h"
+#include "multiqueue_dijkstra.h"
+#include "skiplist_pq.h"
+#include "numa_graph.h"
+#include "lazy_heap.h"
+#include "query_workload.h"
 
 int main(int argc, char** argv) {
     if (argc < 3) {
-        std::cerr << "Usage: ./expParallel_bin <datasetIndex> <numThreads>\n";
+        std::cerr << "Usage: ./expParallel_bin <datasetIndex> <numThreads> [workload.qwl|-] [numaNodes]\n";
+        std::cerr << "  numaNodes: simulated NUMA node count, 0 = detect (default)\n";
         std::cerr << "Example: ./expParallel_bin 1 4\n";
         return 1;
     }
 
     int datasetIdx = std::stoi(argv[1]);
     int numThreads = std::stoi(argv[2]);
+    int numaNodes = argc >= 5 ? std::stoi(argv[4]) : 0;
 
     std::vector<std::string> datasetFiles = {
         "/kaggle/input/road-d-datasets/Hongkong.road-d",
@@ -39,11 +46,21 @@ int main(int argc, char** argv) {
     std::cout << "Loaded graph: " << g.numVertices()
               << " vertices, " << g.numEdges() << " edges\n";
 
-    // choose up to 8 sources spread across the graph
+    // sources from a saved workload (see workload_gen), otherwise up to 8
+    // sources spread across the graph
     std::vector<int> sources;
-    int step = std::max(1, g.numVertices() / 8);
-    for (int s = 0; s < g.numVertices() && (int)sources.size() < 8; s += step) {
-        sources.push_back(s);
+    if (argc >= 4 && std::string(argv[3]) != "-") {
+        QueryWorkload w;
+        if (!w.load(argv[3]) || !w.fits(g)) {
+            std::cerr << "Could not use workload " << argv[3] << "\n";
+            return 1;
+        }
+        sources = w.sources();
+    } else {
+        int step = std::max(1, g.numVertices() / 8);
+        for (int s = 0; s < g.numVertices() && (int)sources.size() < 8; s += step) {
+            sources.push_back(s);
+        }
     }
 
     std::vector<DijkstraMetrics> metricsParallel;
@@ -55,6 +72,26 @@ int main(int argc, char** argv) {
     double sequentialTimeMs = 0.0;
     runDijkstraMultiSource<BinaryHeap>(g, sources, 1, metricsSequential, sequentialTimeMs);
 
+    // shared frontier: all threads on one search from the first source
+    DijkstraMetrics metricsSingle;
+    runDijkstra<BinaryHeap>(g, sources[0], metricsSingle);
+    DijkstraMetrics metricsMQ;
+    MultiQueueStats mqStats;
+    runDijkstraMultiQueue<LazyBinaryHeap>(g, sources[0], numThreads, metricsMQ, &mqStats);
+    DijkstraMetrics metricsSL;
+    SkipListSearchStats slStats;
+    runDijkstraSkipList(g, sources[0], numThreads, metricsSL, &slStats);
+
+    // NUMA: one graph replica per node, workers pinned to their node
+    NumaTopology topo = numaNodes > 0 ? NumaTopology::simulate(numaNodes)
+                                      : NumaTopology::detect();
+    ReplicatedGraph replicated(g, topo);
+    std::vector<DijkstraMetrics> metricsNuma;
+    double numaTimeMs = 0.0;
+    NumaRunStats numaStats;
+    runDijkstraMultiSourceNuma<BinaryHeap>(replicated, sources, numThreads, metricsNuma,
+                                           numaTimeMs, &numaStats);
+
     std::ofstream out("experiment_parallel_binary.txt");
     if (!out.is_open()) {
         std::cerr << "Could not open experiment_parallel_binary.txt\n";
@@ -71,6 +108,32 @@ int main(int argc, char** argv) {
     out << "1\t" << sequentialTimeMs << "\n";
     out << numThreads << "\t" << parallelTimeMs << "\n\n";
 
+    out << "Shared-frontier MultiQueue search from source " << sources[0] << ":\n";
+    out << "Threads\tRuntime_ms\tPops\tStalePops\tLockFailures\tCasFailures\n";
+    out << "1 (sequential binary)\t" << metricsSingle.runtimeMs << "\t"
+        << metricsSingle.extractMins << "\t0\t0\t0\n";
+    out << numThreads << "\t" << metricsMQ.runtimeMs << "\t"
+        << metricsMQ.extractMins << "\t" << mqStats.stalePops << "\t"
+        << mqStats.lockFailures << "\t" << mqStats.casFailures << "\n\n";
+
+    out << "Shared-frontier lock-free skiplist (SprayList pop) from source " << sources[0] << ":\n";
+    out << "Threads\tRuntime_ms\tPops\tStalePops\tInsertCasFailures\tSnipCasFailures"
+        << "\tClaimFailures\tSprayFallbacks\n";
+    out << numThreads << "\t" << metricsSL.runtimeMs << "\t" << metricsSL.extractMins << "\t"
+        << slStats.search.stalePops << "\t" << slStats.queue.insertCasFailures << "\t"
+        << slStats.queue.snipCasFailures << "\t" << slStats.queue.claimFailures << "\t"
+        << slStats.queue.sprayFallbacks << "\n\n";
+
+    out << "NUMA-replicated run (" << topo.numNodes()
+        << (topo.simulated() ? " simulated" : " detected") << " node(s)):\n";
+    out << "Threads\tTotalRuntime_ms\tPinnedThreads\tStolenSources\tSourcesPerNode\n";
+    out << numThreads << "\t" << numaTimeMs << "\t" << numaStats.pinnedThreads << "\t"
+        << numaStats.stolenSources << "\t";
+    for (size_t i = 0; i < numaStats.sourcesPerNode.size(); ++i) {
+        out << (i ? "," : "") << numaStats.sourcesPerNode[i];
+    }
+    out << "\n\n";
+
     out << "Per-source metrics (parallel run):\n";
     out << "Source\tRuntime_ms\tInserts\tExtractMins\tDecreaseKeys\n";
     for (size_t i = 0; i < sources.size(); ++i) {
@@ -0,0 +1,239 @@
+// perf_counters.h
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+// Hardware performance counters via Linux perf_event_open. Everything is
+// counted in user space only, so this works with perf_event_paranoid <= 2.
+// On other platforms, or when the kernel refuses, the group simply reports
+// itself as unavailable and all counts stay invalid.
+//
+// A PMU only has a few counters. When more events are enabled at once than
+// it can hold, the kernel multiplexes them and each group only counts for
+// part of the time; read() scales the counts up by time_enabled /
+// time_running, and PerfCounts::runningFraction() says how much of the time
+// was actually measured (1 = exact).
+
+enum class PerfEvent {
+    Cycles,
+    Instructions,
+    L1DMisses,
+    LLCMisses,
+    BranchMisses,
+    DTLBMisses,
+    Count
+};
+
+inline const char* perfEventName(PerfEvent e) {
+    switch (e) {
+        case PerfEvent::Cycles:       return "cycles";
+        case PerfEvent::Instructions: return "instructions";
+        case PerfEvent::L1DMisses:    return "l1d_misses";
+        case PerfEvent::LLCMisses:    return "llc_misses";
+        case PerfEvent::BranchMisses: return "branch_misses";
+        case PerfEvent::DTLBMisses:   return "dtlb_misses";
+        default:                      return "unknown";
+    }
+}
+
+constexpr int kNumPerfEvents = (int)PerfEvent::Count;
+
+struct PerfCounts {
+    bool valid[kNumPerfEvents] = {};
+    long long value[kNumPerfEvents] = {};
+    unsigned long long timeEnabled = 0; // ns, summed by add()
+    unsigned long long timeRunning = 0;
+
+    long long get(PerfEvent e) const { return value[(int)e]; }
+    bool has(PerfEvent e) const { return valid[(int)e]; }
+
+    void add(const PerfCounts& o) {
+        for (int i = 0; i < kNumPerfEvents; ++i) {
+            if (!o.valid[i]) continue;
+            valid[i] = true;
+            value[i] += o.value[i];
+        }
+        timeEnabled += o.timeEnabled;
+        timeRunning += o.timeRunning;
+    }
+
+    double runningFraction() const {
+        return timeEnabled ? (double)timeRunning / (double)timeEnabled : 1.0;
+    }
+
+    double ipc() const {
+        if (!has(PerfEvent::Cycles) || !has(PerfEvent::Instructions)) return 0.0;
+        long long c = get(PerfEvent::Cycles);
+        return c ? (double)get(PerfEvent::Instructions) / (double)c : 0.0;
+    }
+};
+
+class PerfCounterGroup {
+public:
+    PerfCounterGroup() : leader(-1) {
+        for (int i = 0; i < kNumPerfEvents; ++i) fds[i] = -1;
+        open();
+    }
+
+    ~PerfCounterGroup() {
+        close();
+    }
+
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+    bool available() const { return leader >= 0; }
+    const std::string& error() const { return lastError; }
+
+    void reset() {
+#ifdef __linux__
+        if (leader >= 0) ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    void start() {
+#ifdef __linux__
+        if (leader >= 0) ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    void stop() {
+#ifdef __linux__
+        if (leader >= 0) ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    // Counts accumulated since the last reset(), scaled up if the kernel had
+    // to multiplex the group. A group that was enabled but never got onto
+    // the PMU (time_running == 0) measured nothing, so its counts stay
+    // invalid rather than reading as zeros.
+    PerfCounts read() const {
+        PerfCounts out;
+#ifdef __linux__
+        if (leader < 0) return out;
+        // nr, time_enabled, time_running, then one value per member
+        uint64_t buf[3 + kNumPerfEvents] = {};
+        if (::read(leader, buf, sizeof(buf)) < (ssize_t)(3 * sizeof(uint64_t))) return out;
+        uint64_t nr = buf[0];
+        out.timeEnabled = buf[1];
+        out.timeRunning = buf[2];
+        if (buf[2] == 0) return out;
+        double scale = (buf[2] > 0 && buf[2] < buf[1]) ? (double)buf[1] / (double)buf[2] : 1.0;
+        for (uint64_t i = 0; i < nr && i < members.size(); ++i) {
+            int e = members[i];
+            out.valid[e] = true;
+            out.value[e] = (long long)((double)buf[3 + i] * scale);
+        }
+#endif
+        return out;
+    }
+
+private:
+    int fds[kNumPerfEvents];
+    int leader;
+    std::vector<int> members; // PerfEvent index, in group read order
+    std::string lastError;
+
+#ifdef __linux__
+    static bool eventConfig(PerfEvent e, uint32_t& type, uint64_t& config) {
+        auto cache = [](uint64_t id, uint64_t op, uint64_t result) {
+            return id | (op << 8) | (result << 16);
+        };
+        switch (e) {
+            case PerfEvent::Cycles:
+                type = PERF_TYPE_HARDWARE; config = PERF_COUNT_HW_CPU_CYCLES; return true;
+            case PerfEvent::Instructions:
+                type = PERF_TYPE_HARDWARE; config = PERF_COUNT_HW_INSTRUCTIONS; return true;
+            case PerfEvent::BranchMisses:
+                type = PERF_TYPE_HARDWARE; config = PERF_COUNT_HW_BRANCH_MISSES; return true;
+            case PerfEvent::L1DMisses:
+                type = PERF_TYPE_HW_CACHE;
+                config = cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                               PERF_COUNT_HW_CACHE_RESULT_MISS);
+                return true;
+            case PerfEvent::LLCMisses:
+                type = PERF_TYPE_HW_CACHE;
+                config = cache(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ,
+                               PERF_COUNT_HW_CACHE_RESULT_MISS);
+                return true;
+            case PerfEvent::DTLBMisses:
+                type = PERF_TYPE_HW_CACHE;
+                config = cache(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                               PERF_COUNT_HW_CACHE_RESULT_MISS);
+                return true;
+            default:
+                return false;
+        }
+    }
+#endif
+
+    void open() {
+#ifdef __linux__
+        for (int i = 0; i < kNumPerfEvents; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            uint32_t type;
+            uint64_t config;
+            if (!eventConfig((PerfEvent)i, type, config)) continue;
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = (leader < 0) ? 1 : 0; // the leader gates the group
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP
+                             | PERF_FORMAT_TOTAL_TIME_ENABLED
+                             | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+            if (fd < 0) {
+                if (!lastError.empty()) continue; // keep the first failure
+                lastError = std::string("perf_event_open failed for ")
+                          + perfEventName((PerfEvent)i) + ": " + std::strerror(errno);
+                continue;
+            }
+            fds[i] = fd;
+            if (leader < 0) leader = fd;
+            members.push_back(i);
+        }
+#else
+        lastError = "perf counters are only supported on Linux";
+#endif
+    }
+
+    void close() {
+#ifdef __linux__
+        for (int i = 0; i < kNumPerfEvents; ++i) {
+            if (fds[i] >= 0) ::close(fds[i]);
+            fds[i] = -1;
+        }
+#endif
+        leader = -1;
+        members.clear();
+    }
+};
+
+inline void printPerfCounts(std::ostream& out, const PerfCounts& c) {
+    for (int i = 0; i < kNumPerfEvents; ++i) {
+        out << perfEventName((PerfEvent)i) << ": ";
+        if (c.valid[i]) out << c.value[i];
+        else out << "NA";
+        out << "\n";
+    }
+    out << "ipc: " << c.ipc() << "\n";
+    out << "running: " << c.runningFraction() << "\n";
+}
+
+#endif // PERF_COUNTERS_H
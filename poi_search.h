@@ -0,0 +1,125 @@
+// poi_search.h
+#ifndef POI_SEARCH_H
+#define POI_SEARCH_H
+
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <cstdint>
+#include "graph.h"
+#include "priority_queue.h"
+#include "dijkstra.h"
+
+// Bitset of marked vertices (stations, depots, ...). One bit per vertex so
+// the membership test in the Dijkstra loop stays in cache.
+class PoiSet {
+public:
+    PoiSet() : count(0) {}
+    explicit PoiSet(int numVertices) : bits((numVertices + 63) / 64, 0), count(0) {}
+
+    void mark(int v) {
+        if (!contains(v)) {
+            bits[v >> 6] |= (uint64_t)1 << (v & 63);
+            ++count;
+        }
+    }
+
+    void unmark(int v) {
+        if (contains(v)) {
+            bits[v >> 6] &= ~((uint64_t)1 << (v & 63));
+            --count;
+        }
+    }
+
+    bool contains(int v) const {
+        return (bits[v >> 6] >> (v & 63)) & 1;
+    }
+
+    int size() const { return count; }
+
+private:
+    std::vector<uint64_t> bits;
+    int count;
+};
+
+struct PoiHit {
+    int vertex;
+    double dist;
+};
+
+// k nearest marked vertices by network distance, closest first. The search
+// stops as soon as the k-th POI is settled instead of finishing the SSSP.
+// After the call ws.parent holds the tree, so paths to the hits can be
+// walked back until the workspace is reused.
+template <typename PQType>
+std::vector<PoiHit> findKNearestPois(
+    const Graph& g,
+    int source,
+    const PoiSet& pois,
+    int k,
+    DijkstraMetrics& metrics,
+    DijkstraWorkspace& ws
+) {
+    std::vector<PoiHit> hits;
+    if (k <= 0 || pois.size() == 0) return hits;
+    if (k > pois.size()) k = pois.size();
+    hits.reserve(k);
+
+    ws.prepare(g.numVertices());
+    auto& dist = ws.dist;
+    auto& parent = ws.parent;
+    auto& handles = ws.handles;
+
+    PQType pq;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    dist[source] = 0.0;
+    ws.touch(source);
+    handles[source] = pq.insert(0.0, source);
+    metrics.inserts++;
+
+    while (!pq.empty()) {
+        auto [d, u] = pq.extract_min();
+        metrics.extractMins++;
+        if (d > dist[u]) continue;
+
+        if (pois.contains(u)) {
+            hits.push_back({u, d});
+            if ((int)hits.size() == k) break;
+        }
+
+        for (const auto& e : g.neighbors(u)) {
+            int v = e.to;
+            double nd = d + e.weight;
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                parent[v] = u;
+                if (handles[v] == nullptr) {
+                    ws.touch(v);
+                    handles[v] = pq.insert(nd, v);
+                    metrics.inserts++;
+                } else {
+                    pq.decrease_key(handles[v], nd);
+                    metrics.decreaseKeys++;
+                }
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    metrics.runtimeMs =
+        std::chrono::duration<double, std::milli>(end - start).count();
+
+    return hits;
+}
+
+template <typename PQType>
+std::vector<PoiHit> findKNearestPois(
+    const Graph& g, int source, const PoiSet& pois, int k, DijkstraMetrics& metrics
+) {
+    DijkstraWorkspace ws;
+    return findKNearestPois<PQType>(g, source, pois, k, metrics, ws);
+}
+
+#endif // POI_SEARCH_H
@@ -0,0 +1,249 @@
+// pq_trace.h
+#ifndef PQ_TRACE_H
+#define PQ_TRACE_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <limits>
+#include "priority_queue.h"
+
+// Exact sequence of priority queue calls made by a real Dijkstra run, so that
+// heaps can be compared in isolation on realistic access patterns.
+//
+// Every op is 13 bytes: u8 kind | i32 value | f64 key. For extract_min the
+// value/key are what the recording heap returned, which lets a replay check
+// that the heap under test produces the same keys.
+enum class PQOpKind : uint8_t {
+    Insert = 0,
+    ExtractMin = 1,
+    DecreaseKey = 2
+};
+
+struct PQTraceOp {
+    PQOpKind kind;
+    int value;
+    double key;
+};
+
+class PQTrace {
+public:
+    static constexpr size_t OpBytes = 1 + sizeof(int32_t) + sizeof(double);
+
+    void clear() {
+        data.clear();
+        nOps = 0;
+        maxValue = -1;
+    }
+
+    void append(PQOpKind kind, int value, double key) {
+        size_t pos = data.size();
+        data.resize(pos + OpBytes);
+        unsigned char* p = data.data() + pos;
+        p[0] = (unsigned char)kind;
+        int32_t v = value;
+        std::memcpy(p + 1, &v, sizeof(v));
+        std::memcpy(p + 1 + sizeof(v), &key, sizeof(key));
+        ++nOps;
+        if (value > maxValue) maxValue = value;
+    }
+
+    size_t size() const { return nOps; }
+    int getMaxValue() const { return maxValue; }
+
+    PQTraceOp op(size_t i) const {
+        const unsigned char* p = data.data() + i * OpBytes;
+        PQTraceOp o;
+        o.kind = (PQOpKind)p[0];
+        int32_t v;
+        std::memcpy(&v, p + 1, sizeof(v));
+        o.value = v;
+        std::memcpy(&o.key, p + 1 + sizeof(v), sizeof(o.key));
+        return o;
+    }
+
+    // File: "PQT1" | u64 opCount | i32 maxValue | ops
+    bool save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary);
+        if (!out.is_open()) {
+            std::cerr << "Error: cannot open file " << path << std::endl;
+            return false;
+        }
+        uint64_t count = nOps;
+        int32_t mv = maxValue;
+        out.write("PQT1", 4);
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        out.write(reinterpret_cast<const char*>(&mv), sizeof(mv));
+        out.write(reinterpret_cast<const char*>(data.data()), (std::streamsize)data.size());
+        return (bool)out;
+    }
+
+    bool load(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open()) {
+            std::cerr << "Error: cannot open file " << path << std::endl;
+            return false;
+        }
+        char magic[4];
+        uint64_t count = 0;
+        int32_t mv = -1;
+        in.read(magic, 4);
+        in.read(reinterpret_cast<char*>(&count), sizeof(count));
+        in.read(reinterpret_cast<char*>(&mv), sizeof(mv));
+        if (!in || std::memcmp(magic, "PQT1", 4) != 0) {
+            std::cerr << "Error: " << path << " is not a priority queue trace" << std::endl;
+            return false;
+        }
+        // Check the header count against the file before allocating for it.
+        std::streamoff body = in.tellg();
+        in.seekg(0, std::ios::end);
+        std::streamoff fileEnd = in.tellg();
+        in.seekg(body);
+        if (!in || body < 0 || fileEnd < body || count > SIZE_MAX / OpBytes
+            || count > (uint64_t)(fileEnd - body) / OpBytes) {
+            std::cerr << "Error: truncated trace " << path << std::endl;
+            return false;
+        }
+        std::vector<unsigned char> buf((size_t)count * OpBytes);
+        in.read(reinterpret_cast<char*>(buf.data()), (std::streamsize)buf.size());
+        if (!in) {
+            std::cerr << "Error: truncated trace " << path << std::endl;
+            return false;
+        }
+        // replayTrace indexes its handles by value, so every op must stay
+        // within [0, maxValue] and never extract from an empty queue.
+        // An empty trace is saved with maxValue -1.
+        bool valid = mv >= -1;
+        uint64_t live = 0;
+        for (uint64_t i = 0; valid && i < count; ++i) {
+            const unsigned char* p = buf.data() + i * OpBytes;
+            int32_t v;
+            std::memcpy(&v, p + 1, sizeof(v));
+            if (v < 0 || v > mv) valid = false;
+            else if (p[0] == (unsigned char)PQOpKind::Insert) ++live;
+            else if (p[0] == (unsigned char)PQOpKind::ExtractMin) valid = live-- > 0;
+            else if (p[0] != (unsigned char)PQOpKind::DecreaseKey) valid = false;
+        }
+        if (!valid) {
+            std::cerr << "Error: corrupt trace " << path << std::endl;
+            return false;
+        }
+        data.swap(buf);
+        nOps = count;
+        maxValue = mv;
+        return true;
+    }
+
+    // Sink for default-constructed TracingPQs, one per thread.
+    static PQTrace& threadDefault() {
+        static thread_local PQTrace trace;
+        return trace;
+    }
+
+private:
+    std::vector<unsigned char> data;
+    size_t nOps = 0;
+    int maxValue = -1;
+};
+
+// Records every call into a PQTrace while forwarding to PQType:
+//   PQTrace::threadDefault().clear();
+//   runDijkstra<TracingPQ<BinaryHeap>>(g, source, metrics);
+//   PQTrace::threadDefault().save("hongkong.pqt");
+template <typename PQType>
+class TracingPQ : public PriorityQueue {
+public:
+    TracingPQ() : trace(PQTrace::threadDefault()) {}
+    explicit TracingPQ(PQTrace& t) : trace(t) {}
+
+    PQNodeBase* insert(double key, int value) override {
+        PQNodeBase* n = inner.insert(key, value);
+        handleValue[n] = value;
+        trace.append(PQOpKind::Insert, value, key);
+        return n;
+    }
+
+    bool empty() const override { return inner.empty(); }
+    std::pair<double,int> find_min() const override { return inner.find_min(); }
+
+    std::pair<double,int> extract_min() override {
+        auto res = inner.extract_min();
+        trace.append(PQOpKind::ExtractMin, res.second, res.first);
+        return res;
+    }
+
+    void decrease_key(PQNodeBase* node, double new_key) override {
+        auto it = handleValue.find(node);
+        if (it != handleValue.end()) {
+            trace.append(PQOpKind::DecreaseKey, it->second, new_key);
+        }
+        inner.decrease_key(node, new_key);
+    }
+
+    void remove(PQNodeBase* node) override { inner.remove(node); }
+
+    int getSize() const override { return inner.getSize(); }
+    int getHeightEstimate() const override { return inner.getHeightEstimate(); }
+    int getNumTrees() const override { return inner.getNumTrees(); }
+    long long getNumCascadingCuts() const override { return inner.getNumCascadingCuts(); }
+    double getMemoryUsageMBEstimate() const override { return inner.getMemoryUsageMBEstimate(); }
+
+private:
+    PQType inner;
+    PQTrace& trace;
+    std::unordered_map<PQNodeBase*, int> handleValue;
+};
+
+struct ReplayResult {
+    double runtimeMs = 0.0;
+    long long inserts = 0;
+    long long extractMins = 0;
+    long long decreaseKeys = 0;
+    long long keyMismatches = 0; // extract_min keys that differ from the trace
+};
+
+// Drives PQType with the recorded calls. Handles are indexed by value, as in
+// runDijkstra. Pass an InstrumentedPQ<...> to get latency distributions.
+template <typename PQType>
+ReplayResult replayTrace(const PQTrace& trace, PQType& pq) {
+    ReplayResult r;
+    std::vector<PQNodeBase*> handles(trace.getMaxValue() + 1, nullptr);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < trace.size(); ++i) {
+        PQTraceOp o = trace.op(i);
+        switch (o.kind) {
+            case PQOpKind::Insert:
+                handles[o.value] = pq.insert(o.key, o.value);
+                r.inserts++;
+                break;
+            case PQOpKind::ExtractMin: {
+                auto res = pq.extract_min();
+                if (res.first != o.key) r.keyMismatches++;
+                handles[res.second] = nullptr; // node is gone
+                r.extractMins++;
+                break;
+            }
+            case PQOpKind::DecreaseKey:
+                if (handles[o.value]) pq.decrease_key(handles[o.value], o.key);
+                r.decreaseKeys++;
+                break;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    r.runtimeMs = std::chrono::duration<double, std::milli>(end - start).count();
+    return r;
+}
+
+template <typename PQType>
+ReplayResult replayTrace(const PQTrace& trace) {
+    PQType pq;
+    return replayTrace(trace, pq);
+}
+
+#endif // PQ_TRACE_H
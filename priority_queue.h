@@ -3,12 +3,24 @@
 #define PRIORITY_QUEUE_H
 
 #include <limits>
+#include <cstddef>
+#include <utility>
+#include "memory_tracker.h"
 
 // We assume: key = double (distance), value = int (vertex id)
 
 class PQNodeBase {
 public:
     virtual ~PQNodeBase() = default;
+
+    // Every heap node is charged to MemComponent::HeapNodes. The virtual
+    // destructor makes sure the sized delete sees the derived class size.
+    static void* operator new(size_t bytes) {
+        return trackedAllocate(MemComponent::HeapNodes, bytes);
+    }
+    static void operator delete(void* p, size_t bytes) {
+        trackedDeallocate(MemComponent::HeapNodes, p, bytes);
+    }
 };
 
 class PriorityQueue {
@@ -22,6 +34,18 @@ public:
     virtual void decrease_key(PQNodeBase* node, double new_key) = 0;
     virtual void remove(PQNodeBase* node) = 0;
 
+    // Inserts count (key, value) pairs before any further extract, e.g. the
+    // seeds of a multi-source search. If handles is not null, handles[i]
+    // receives the node of items[i]. The default inserts one at a time;
+    // heaps override it where a batch is cheaper to build.
+    virtual void bulk_insert(const std::pair<double,int>* items, size_t count,
+                             PQNodeBase** handles) {
+        for (size_t i = 0; i < count; ++i) {
+            PQNodeBase* h = insert(items[i].first, items[i].second);
+            if (handles) handles[i] = h;
+        }
+    }
+
     // For metrics
     virtual int getSize() const = 0;
     virtual int getHeightEstimate() const = 0;
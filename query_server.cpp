@@ -0,0 +1,311 @@
+// query_server.cpp
+// Shortest-path query service (QueryRouter) behind a loopback socket, and a
+// load generator for it.
+//
+// Build: g++ -O2 -std=c++20 -pthread query_server.cpp -o query_server
+// Usage:
+//   ./query_server serve --graph Hongkong.road-d --unix /tmp/sp.sock --workers 4
+//   ./query_server bench --graph Hongkong.road-d --workload hk_rank.qwl
+//                        --clients 8 --depth 16 --verify 200
+//   ./query_server bench --gen grid:300x300 --frontend coro --clients 32
+//   ./query_server bench --graph Hongkong.road-d --directed --components --verify 1000
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <cmath>
+#include <csignal>
+#include <unistd.h>
+
+#include "graph.h"
+#include "graph_generators.h"
+#include "graph_components.h"
+#include "query_workload.h"
+#include "query_service.h"
+#include "query_socket.h"
+#include "latency_histogram.h"
+#include "binary_heap.h"
+
+using Router = QueryRouter<BinaryHeap>;
+
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void onSignal(int) { stopRequested = 1; }
+
+static void printUsage() {
+    std::cerr <<
+        "Usage: ./query_server <serve|bench> (--graph FILE | --gen SPEC) [options]\n"
+        "  --directed               load / generate a directed graph\n"
+        "  --seed S                 seed for --gen and the default workload (default 1)\n"
+        "  --workers N              search threads (default: hardware threads)\n"
+        "  --max-batch B            queries answered by one search (default 64)\n"
+        "  --components             precompute components / SCCs and answer\n"
+        "                           unreachable queries without a search\n"
+        "  --tcp PORT               listen on 127.0.0.1:PORT (0 = any free port)\n"
+        "  --unix PATH              listen on a Unix socket (default for bench)\n"
+        "  --max-inflight N         requests read ahead of written responses, per\n"
+        "                           connection (default 256)\n"
+        "  --workload FILE          bench: queries to send (default: rank queries\n"
+        "                           from 100 random sources)\n"
+        "  --frontend socket|coro   bench: through the socket, or co_await in-process\n"
+        "  --clients C              bench: connections / coroutines (default 4)\n"
+        "  --depth D                bench: requests in flight per client (default 8)\n"
+        "  --paths                  bench: ask for the vertex path too\n"
+        "  --verify K               bench: check the first K answers against runDijkstra\n";
+}
+
+struct BenchResult {
+    std::vector<double> dist;
+    LatencyHistogram latencyNs;
+    long long failed = 0;
+};
+
+static uint64_t nowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Client c sends queries [c*n/C, (c+1)*n/C) with up to depth in flight, so
+// queries that share a source arrive close together and can be batched.
+static bool runSocketClients(const std::vector<Query>& qs, int clients, int depth, bool paths,
+                             const std::string& unixPath, int tcpPort, BenchResult& out) {
+    std::vector<LatencyHistogram> hist(clients);
+    std::atomic<long long> failed{0};
+    std::vector<std::thread> threads;
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c]() {
+            size_t begin = qs.size() * c / clients, end = qs.size() * (c + 1) / clients;
+            QuerySocketClient client;
+            bool ok = unixPath.empty() ? client.connectTcp(tcpPort) : client.connectUnix(unixPath);
+            if (!ok) {
+                failed += (long long)(end - begin);
+                return;
+            }
+            std::vector<uint64_t> sentAt(end - begin);
+            size_t next = begin, done = begin;
+            WireResponse resp;
+            while (done < end) {
+                while (next < end && next - done < (size_t)depth) {
+                    WireRequest req;
+                    req.id = (uint32_t)next;
+                    req.source = qs[next].source;
+                    req.target = qs[next].target;
+                    req.flags = paths ? WireRequest::WantPath : 0;
+                    sentAt[next - begin] = nowNs();
+                    if (!client.send(req)) break;
+                    ++next;
+                }
+                if (!client.receive(resp)) {
+                    failed += (long long)(end - done);
+                    return;
+                }
+                hist[c].record(nowNs() - sentAt[resp.id - begin]);
+                out.dist[resp.id] = resp.status == QueryStatus::Invalid ? NAN : resp.dist;
+                ++done;
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    for (const auto& h : hist) out.latencyNs.merge(h);
+    out.failed = failed.load();
+    return out.failed == 0;
+}
+
+static QueryTask coroClient(Router& router, const std::vector<Query>& qs, size_t begin,
+                            size_t end, size_t step, bool paths, BenchResult& out,
+                            LatencyHistogram& hist) {
+    for (size_t i = begin; i < end; i += step) {
+        uint64_t t0 = nowNs();
+        PathQueryResult res = co_await router.shortestPath(qs[i].source, qs[i].target, paths);
+        hist.record(nowNs() - t0);
+        out.dist[i] = res.valid ? res.dist : NAN;
+    }
+}
+
+// Same split as the socket clients; each client is depth coroutines that
+// take every depth-th query of its range, one co_await at a time.
+static void runCoroClients(Router& router, const std::vector<Query>& qs, int clients, int depth,
+                           bool paths, BenchResult& out) {
+    std::vector<LatencyHistogram> hist(clients * depth);
+    std::vector<QueryTask> running;
+    for (int c = 0; c < clients; ++c) {
+        size_t begin = qs.size() * c / clients, end = qs.size() * (c + 1) / clients;
+        for (int k = 0; k < depth; ++k) {
+            running.push_back(coroClient(router, qs, begin + k, end, depth, paths, out,
+                                         hist[c * depth + k]));
+        }
+    }
+    for (auto& t : running) t.wait();
+    for (const auto& h : hist) out.latencyNs.merge(h);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+    std::string mode = argv[1];
+    std::string graphPath, genSpec, unixPath, workloadPath, frontend = "socket";
+    bool directed = false, paths = false, useComponents = false;
+    unsigned long long seed = 1;
+    int tcpPort = -1, clients = 4, depth = 8, verify = 0, maxInFlight = 256;
+    QueryRouterOptions opt;
+    opt.numWorkers = (int)std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 2; i < argc; ++i) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        try {
+            if (a == "--graph" && hasValue) graphPath = argv[++i];
+            else if (a == "--gen" && hasValue) genSpec = argv[++i];
+            else if (a == "--seed" && hasValue) seed = std::stoull(argv[++i]);
+            else if (a == "--workers" && hasValue) opt.numWorkers = std::stoi(argv[++i]);
+            else if (a == "--max-batch" && hasValue) opt.maxBatch = std::stoi(argv[++i]);
+            else if (a == "--tcp" && hasValue) tcpPort = std::stoi(argv[++i]);
+            else if (a == "--unix" && hasValue) unixPath = argv[++i];
+            else if (a == "--max-inflight" && hasValue) maxInFlight = std::stoi(argv[++i]);
+            else if (a == "--workload" && hasValue) workloadPath = argv[++i];
+            else if (a == "--frontend" && hasValue) frontend = argv[++i];
+            else if (a == "--clients" && hasValue) clients = std::stoi(argv[++i]);
+            else if (a == "--depth" && hasValue) depth = std::stoi(argv[++i]);
+            else if (a == "--verify" && hasValue) verify = std::stoi(argv[++i]);
+            else if (a == "--directed") directed = true;
+            else if (a == "--paths") paths = true;
+            else if (a == "--components") useComponents = true;
+            else {
+                std::cerr << "Error: unknown or incomplete option " << a << "\n";
+                printUsage();
+                return 1;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Error: invalid value for " << a << "\n";
+            return 1;
+        }
+    }
+    if ((mode != "serve" && mode != "bench") || graphPath.empty() == genSpec.empty()
+        || (frontend != "socket" && frontend != "coro")) {
+        printUsage();
+        return 1;
+    }
+    if (tcpPort >= 0 && !unixPath.empty()) {
+        std::cerr << "Error: use either --tcp or --unix\n";
+        return 1;
+    }
+    if (clients < 1) clients = 1;
+    if (depth < 1) depth = 1;
+
+    Graph g;
+    if (!genSpec.empty()) {
+        if (!generateGraphFromSpec(g, genSpec, seed, !directed)) return 1;
+    } else if (!g.loadRoadD(graphPath, !directed)) {
+        return 1;
+    }
+    std::cout << "Graph: " << g.numVertices() << " vertices, " << g.numEdges() << " edges\n";
+
+    GraphComponents comps;
+    if (useComponents) {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        comps.build(g);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        std::cout << "Components: " << comps.numComponents() << " (largest "
+                  << comps.componentSize(comps.largestComponent()) << " vertices)";
+        if (comps.directed()) std::cout << ", " << comps.numStrongComponents() << " SCCs";
+        std::cout << ", " << std::chrono::duration<double, std::milli>(t2 - t1).count()
+                  << " ms\n";
+        opt.components = &comps;
+    }
+
+    Router router(g, opt);
+    QuerySocketServer<BinaryHeap> server(router, (size_t)std::max(1, maxInFlight));
+    bool useSocket = mode == "serve" || frontend == "socket";
+    if (useSocket) {
+        if (tcpPort < 0 && unixPath.empty()) {
+            if (mode == "serve") {
+                std::cerr << "Error: serve needs --tcp or --unix\n";
+                return 1;
+            }
+            unixPath = "/tmp/query_server." + std::to_string(getpid()) + ".sock";
+        }
+        bool ok = unixPath.empty() ? server.listenTcp(tcpPort) : server.listenUnix(unixPath);
+        if (!ok) return 1;
+        if (unixPath.empty()) std::cout << "Listening on 127.0.0.1:" << server.port() << "\n";
+        else std::cout << "Listening on " << unixPath << "\n";
+    }
+
+    if (mode == "serve") {
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        std::cout << opt.numWorkers << " workers; Ctrl-C to stop\n";
+        while (!stopRequested) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        server.stop();
+        QueryRouterStats st = router.stats();
+        std::cout << "Answered " << st.queries << " queries with " << st.searches
+                  << " searches (" << st.pruned << " pruned)\n";
+        return 0;
+    }
+
+    QueryWorkload w;
+    if (!workloadPath.empty()) {
+        if (!w.load(workloadPath) || !w.fits(g)) {
+            std::cerr << "Could not use workload " << workloadPath << "\n";
+            return 1;
+        }
+    } else {
+        w = generateRankQueries(g, 100, seed, 1, -1);
+    }
+    const std::vector<Query>& qs = w.queries;
+
+    BenchResult res;
+    res.dist.assign(qs.size(), NAN);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    if (frontend == "socket") {
+        runSocketClients(qs, clients, depth, paths, unixPath, server.port(), res);
+    } else {
+        runCoroClients(router, qs, clients, depth, paths, res);
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    double wallMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    server.stop();
+
+    QueryRouterStats st = router.stats();
+    std::cout << "Queries: " << qs.size() << " (" << w.kind << ", " << w.sources().size()
+              << " sources), frontend " << frontend << ", " << clients << " clients x depth "
+              << depth << ", " << opt.numWorkers << " workers\n";
+    if (res.failed) std::cout << "Failed: " << res.failed << "\n";
+    std::cout << "Wall: " << wallMs << " ms, " << (qs.size() / (wallMs / 1000.0)) << " queries/s\n";
+    std::cout << "Latency us: mean " << res.latencyNs.mean() / 1000.0
+              << ", p50 " << res.latencyNs.percentile(0.50) / 1000.0
+              << ", p99 " << res.latencyNs.percentile(0.99) / 1000.0
+              << ", max " << res.latencyNs.max() / 1000.0 << "\n";
+    std::cout << "Searches: " << st.searches << " for " << st.queries << " queries ("
+              << (st.searches ? (double)(st.queries - st.pruned) / st.searches : 0.0) << " per search; "
+              << st.forwardBatches << " same-source and " << st.backwardBatches
+              << " same-target batches), " << st.extractMins << " extract-mins\n";
+    if (useComponents) {
+        std::cout << "Pruned: " << st.pruned << " queries answered unreachable without a search\n";
+    }
+
+    if (verify > 0) {
+        int checked = 0, wrong = 0;
+        DijkstraMetrics m;
+        for (size_t i = 0; i < qs.size() && checked < verify; ++i, ++checked) {
+            DijkstraResult ref = runDijkstra<BinaryHeap>(g, qs[i].source, m);
+            double want = ref.dist[qs[i].target];
+            double got = res.dist[i];
+            bool same = std::isinf(want) ? std::isinf(got)
+                                         : std::fabs(want - got) <= 1e-9 * std::max(1.0, want);
+            if (!same) {
+                if (wrong < 5) {
+                    std::cerr << "Mismatch: " << qs[i].source << " -> " << qs[i].target
+                              << ": got " << got << ", expected " << want << "\n";
+                }
+                ++wrong;
+            }
+        }
+        std::cout << "Verified " << checked << " answers, " << wrong << " wrong\n";
+        if (wrong) return 1;
+    }
+    return res.failed ? 1 : 0;
+}
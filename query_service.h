@@ -0,0 +1,368 @@
+// query_service.h
+#ifndef QUERY_SERVICE_H
+#define QUERY_SERVICE_H
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <utility>
+#include <coroutine>
+#include "graph.h"
+#include "dijkstra.h"
+#include "batch_dijkstra.h"
+#include "graph_components.h"
+#include "binary_heap.h"
+
+// In-process shortest-path query service. Needs C++20 (-std=c++20) for the
+// coroutine API; everything else in the repo stays C++17.
+//
+//   QueryRouter<PQ> router(g, opts);
+//   QueryTask client(QueryRouter<PQ>& r) {
+//       PathQueryResult res = co_await r.shortestPath(s, t);
+//       ...
+//   }
+//
+// Requests go into one queue. A worker takes the oldest request plus every
+// queued request that shares its source (or, if more of them do, its
+// target) and answers them all with a single search from that vertex
+// (runDijkstraBatch). Each worker keeps one DijkstraWorkspace, so a search
+// costs O(settled) to reset instead of O(n) to allocate. An awaiting
+// coroutine is resumed on the worker thread that answered it.
+//
+// With options.components, queries whose target is known to be unreachable
+// (GraphComponents::reachability() == No) are answered inf at once, without
+// queueing, like out-of-range ones.
+
+struct PathQueryResult {
+    int source = -1;
+    int target = -1;
+    double dist = std::numeric_limits<double>::infinity(); // inf if unreachable
+    bool valid = false;    // both ids in range
+    int batchSize = 0;     // queries answered by the same search
+    std::vector<int> path; // source .. target, only if requested and reachable
+};
+
+struct QueryRouterOptions {
+    int numWorkers = 1;
+    int maxBatch = 64;       // queries answered by one search, at most
+    int batchWindow = 1024;  // queued requests examined when forming a batch
+    const GraphComponents* components = nullptr; // built for the graph; must outlive the router
+};
+
+struct QueryRouterStats {
+    long long queries = 0;          // answered, including invalid ones
+    long long searches = 0;         // runDijkstraBatch calls
+    long long forwardBatches = 0;   // searches for a shared source (> 1 query)
+    long long backwardBatches = 0;  // searches for a shared target (> 1 query)
+    long long extractMins = 0;      // summed over all searches
+    long long pruned = 0;           // answered unreachable from components alone
+};
+
+template <typename PQType>
+class QueryRouter;
+
+// co_await router.shortestPath(s, t) yields a PathQueryResult. Queries that
+// need no search complete immediately without suspending.
+template <typename PQType>
+class ShortestPathAwaitable {
+public:
+    ShortestPathAwaitable(QueryRouter<PQType>& r, int s, int t, bool withPath)
+        : router(r), withPath(withPath) {
+        result.source = s;
+        result.target = t;
+    }
+
+    bool await_ready() {
+        if (router.needsSearch(result.source, result.target)) return false;
+        result = router.answerWithoutSearch(result.source, result.target);
+        return true;
+    }
+
+    // The worker may resume the coroutine before submit() returns, so
+    // nothing here touches *this after the call.
+    void await_suspend(std::coroutine_handle<> h) {
+        router.submit(result.source, result.target, withPath,
+                      [this, h](PathQueryResult&& r) {
+                          result = std::move(r);
+                          h.resume();
+                      });
+    }
+
+    PathQueryResult await_resume() { return std::move(result); }
+
+private:
+    QueryRouter<PQType>& router;
+    bool withPath;
+    PathQueryResult result;
+};
+
+template <typename PQType = BinaryHeap>
+class QueryRouter {
+public:
+    // Called on a worker thread (or inline for queries that need no
+    // search); must not throw.
+    using Callback = std::function<void(PathQueryResult&&)>;
+
+    explicit QueryRouter(const Graph& graph,
+                         const QueryRouterOptions& options = QueryRouterOptions())
+        : g(graph), opt(options) {
+        if (opt.numWorkers < 1) opt.numWorkers = 1;
+        if (opt.maxBatch < 1) opt.maxBatch = 1;
+        if (opt.batchWindow < opt.maxBatch) opt.batchWindow = opt.maxBatch;
+        if (opt.components && !opt.components->matches(g)) {
+            std::cerr << "Error: components were built for a different graph; not pruning\n";
+            opt.components = nullptr;
+        }
+        for (int i = 0; i < opt.numWorkers; ++i) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    // Answers everything still queued, then joins the workers.
+    ~QueryRouter() {
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto& th : workers) th.join();
+    }
+
+    QueryRouter(const QueryRouter&) = delete;
+    QueryRouter& operator=(const QueryRouter&) = delete;
+
+    bool validQuery(int s, int t) const {
+        int n = g.numVertices();
+        return s >= 0 && s < n && t >= 0 && t < n;
+    }
+
+    // False for out-of-range queries and, with components, for pairs that
+    // are certainly unreachable.
+    bool needsSearch(int s, int t) const {
+        if (!validQuery(s, t)) return false;
+        return !opt.components || opt.components->reachability(s, t) != Reachability::No;
+    }
+
+    // The answer to a query for which needsSearch() is false.
+    PathQueryResult answerWithoutSearch(int s, int t) {
+        PathQueryResult res;
+        res.source = s;
+        res.target = t;
+        res.valid = validQuery(s, t);
+        answered.fetch_add(1, std::memory_order_relaxed);
+        if (res.valid) pruned.fetch_add(1, std::memory_order_relaxed);
+        return res;
+    }
+
+    void submit(int s, int t, bool withPath, Callback done) {
+        if (!needsSearch(s, t)) {
+            done(answerWithoutSearch(s, t));
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            queue.push_back(Request{s, t, withPath, std::move(done)});
+        }
+        cv.notify_one();
+    }
+
+    ShortestPathAwaitable<PQType> shortestPath(int s, int t, bool withPath = false) {
+        return ShortestPathAwaitable<PQType>(*this, s, t, withPath);
+    }
+
+    QueryRouterStats stats() const {
+        QueryRouterStats st;
+        st.queries = answered.load(std::memory_order_relaxed);
+        st.searches = searches.load(std::memory_order_relaxed);
+        st.forwardBatches = forwardBatches.load(std::memory_order_relaxed);
+        st.backwardBatches = backwardBatches.load(std::memory_order_relaxed);
+        st.extractMins = extractMins.load(std::memory_order_relaxed);
+        st.pruned = pruned.load(std::memory_order_relaxed);
+        return st;
+    }
+
+    const Graph& graph() const { return g; }
+
+private:
+    struct Request {
+        int source;
+        int target;
+        bool withPath;
+        Callback done;
+    };
+
+    const Graph& g;
+    QueryRouterOptions opt;
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<Request> queue;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+
+    std::atomic<long long> answered{0};
+    std::atomic<long long> searches{0};
+    std::atomic<long long> forwardBatches{0};
+    std::atomic<long long> backwardBatches{0};
+    std::atomic<long long> extractMins{0};
+    std::atomic<long long> pruned{0};
+
+    // Moves the oldest request and up to maxBatch - 1 compatible ones from
+    // the first batchWindow queued requests into batch. Requires the lock
+    // and a non-empty queue.
+    bool takeBatch(std::vector<Request>& batch) {
+        size_t window = std::min(queue.size(), (size_t)opt.batchWindow);
+        int s = queue.front().source;
+        int t = queue.front().target;
+        size_t sameSource = 0, sameTarget = 0;
+        for (size_t i = 0; i < window; ++i) {
+            if (queue[i].source == s) ++sameSource;
+            if (queue[i].target == t) ++sameTarget;
+        }
+        bool reverse = sameTarget > sameSource;
+
+        size_t keep = 0;
+        for (size_t i = 0; i < window; ++i) {
+            bool match = reverse ? queue[i].target == t : queue[i].source == s;
+            if (match && batch.size() < (size_t)opt.maxBatch) {
+                batch.push_back(std::move(queue[i]));
+            } else {
+                if (keep != i) queue[keep] = std::move(queue[i]);
+                ++keep;
+            }
+        }
+        queue.erase(queue.begin() + keep, queue.begin() + window);
+        return reverse;
+    }
+
+    void workerLoop() {
+        DijkstraWorkspace ws;
+        std::vector<Request> batch;
+        std::vector<int> others;
+        std::vector<double> dists;
+        while (true) {
+            bool reverse;
+            {
+                std::unique_lock<std::mutex> lk(mtx);
+                cv.wait(lk, [this]() { return stopping || !queue.empty(); });
+                if (queue.empty()) return;
+                reverse = takeBatch(batch);
+            }
+            int root = reverse ? batch[0].target : batch[0].source;
+            others.clear();
+            for (const auto& r : batch) others.push_back(reverse ? r.source : r.target);
+
+            DijkstraMetrics m;
+            runDijkstraBatch<PQType>(g, root, others, reverse, dists, m, ws);
+            searches.fetch_add(1, std::memory_order_relaxed);
+            extractMins.fetch_add(m.extractMins, std::memory_order_relaxed);
+            if (batch.size() > 1) (reverse ? backwardBatches : forwardBatches).fetch_add(1, std::memory_order_relaxed);
+            answered.fetch_add((long long)batch.size(), std::memory_order_relaxed);
+
+            for (size_t i = 0; i < batch.size(); ++i) {
+                PathQueryResult res;
+                res.source = batch[i].source;
+                res.target = batch[i].target;
+                res.dist = dists[i];
+                res.valid = true;
+                res.batchSize = (int)batch.size();
+                if (batch[i].withPath) appendBatchPath(ws, root, others[i], reverse, res.path);
+                batch[i].done(std::move(res));
+            }
+            batch.clear();
+        }
+    }
+};
+
+// Eager coroutine for callers of the co_await API: runs until its first
+// suspension when created; wait() blocks until it has finished and rethrows
+// anything it threw. Destroying an unfinished task waits for it.
+class QueryTask {
+public:
+    struct State {
+        std::mutex mtx;
+        std::condition_variable cv;
+        bool done = false;
+        std::exception_ptr error;
+    };
+
+    struct promise_type {
+        std::shared_ptr<State> state = std::make_shared<State>();
+
+        QueryTask get_return_object() {
+            return QueryTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+
+        // Signals completion only once the frame is suspended, so wait() may
+        // destroy it as soon as it returns.
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                std::shared_ptr<State> st = h.promise().state;
+                std::lock_guard<std::mutex> lk(st->mtx);
+                st->done = true;
+                st->cv.notify_all();
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+        void unhandled_exception() { state->error = std::current_exception(); }
+    };
+
+    QueryTask(QueryTask&& o) noexcept : h(std::exchange(o.h, nullptr)), state(std::move(o.state)) {}
+    QueryTask& operator=(QueryTask&& o) noexcept {
+        if (this != &o) {
+            finish();
+            h = std::exchange(o.h, nullptr);
+            state = std::move(o.state);
+        }
+        return *this;
+    }
+    QueryTask(const QueryTask&) = delete;
+    QueryTask& operator=(const QueryTask&) = delete;
+
+    ~QueryTask() { finish(); }
+
+    void wait() {
+        if (!state) return;
+        std::unique_lock<std::mutex> lk(state->mtx);
+        state->cv.wait(lk, [this]() { return state->done; });
+        if (state->error) std::rethrow_exception(std::exchange(state->error, nullptr));
+    }
+
+    bool done() const {
+        if (!state) return true;
+        std::lock_guard<std::mutex> lk(state->mtx);
+        return state->done;
+    }
+
+private:
+    std::coroutine_handle<promise_type> h;
+    std::shared_ptr<State> state;
+
+    explicit QueryTask(std::coroutine_handle<promise_type> handle)
+        : h(handle), state(handle.promise().state) {}
+
+    void finish() {
+        if (!h) return;
+        {
+            std::unique_lock<std::mutex> lk(state->mtx);
+            state->cv.wait(lk, [this]() { return state->done; });
+        }
+        h.destroy();
+        h = nullptr;
+    }
+};
+
+#endif // QUERY_SERVICE_H
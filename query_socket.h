@@ -0,0 +1,467 @@
+// query_socket.h
+#ifndef QUERY_SOCKET_H
+#define QUERY_SOCKET_H
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <iostream>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include "query_service.h"
+
+// Loopback socket front end for QueryRouter (TCP on 127.0.0.1 or a Unix
+// socket), so the service can be load-tested locally. POSIX only.
+//
+// Binary protocol, host byte order (both ends are on the same machine):
+//   request   16 bytes: u32 id | i32 source | i32 target | u32 flags
+//             flags bit 0: include the path
+//   response  20 bytes: u32 id | u32 status | f64 dist | u32 pathLength,
+//             then pathLength i32 vertices, source first
+// A client may pipeline requests; responses come back in completion order
+// and are matched by id. The server reads at most maxInFlight requests
+// ahead of the responses it has written, then stops reading until the
+// client drains responses, so a client must keep reading while it sends.
+
+enum class QueryStatus : uint32_t {
+    Ok = 0,
+    Unreachable = 1,
+    Invalid = 2
+};
+
+struct WireRequest {
+    static constexpr size_t Bytes = 16;
+    static constexpr uint32_t WantPath = 1;
+
+    uint32_t id = 0;
+    int32_t source = -1;
+    int32_t target = -1;
+    uint32_t flags = 0;
+
+    void encode(unsigned char* p) const {
+        std::memcpy(p, &id, 4);
+        std::memcpy(p + 4, &source, 4);
+        std::memcpy(p + 8, &target, 4);
+        std::memcpy(p + 12, &flags, 4);
+    }
+
+    void decode(const unsigned char* p) {
+        std::memcpy(&id, p, 4);
+        std::memcpy(&source, p + 4, 4);
+        std::memcpy(&target, p + 8, 4);
+        std::memcpy(&flags, p + 12, 4);
+    }
+};
+
+struct WireResponse {
+    static constexpr size_t HeaderBytes = 20;
+
+    uint32_t id = 0;
+    QueryStatus status = QueryStatus::Invalid;
+    double dist = 0.0;
+    std::vector<int32_t> path;
+
+    void encode(std::vector<unsigned char>& out) const {
+        uint32_t st = (uint32_t)status;
+        uint32_t len = (uint32_t)path.size();
+        out.resize(HeaderBytes + path.size() * 4);
+        unsigned char* p = out.data();
+        std::memcpy(p, &id, 4);
+        std::memcpy(p + 4, &st, 4);
+        std::memcpy(p + 8, &dist, 8);
+        std::memcpy(p + 16, &len, 4);
+        if (len) std::memcpy(p + HeaderBytes, path.data(), path.size() * 4);
+    }
+
+    // Returns the path length the header announces.
+    uint32_t decodeHeader(const unsigned char* p) {
+        uint32_t st, len;
+        std::memcpy(&id, p, 4);
+        std::memcpy(&st, p + 4, 4);
+        std::memcpy(&dist, p + 8, 8);
+        std::memcpy(&len, p + 16, 4);
+        status = (QueryStatus)st;
+        return len;
+    }
+};
+
+namespace qsock_detail {
+
+inline bool readAll(int fd, void* buf, size_t len) {
+    char* p = static_cast<char*>(buf);
+    while (len > 0) {
+        ssize_t r = ::recv(fd, p, len, 0);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        p += r;
+        len -= (size_t)r;
+    }
+    return true;
+}
+
+// MSG_NOSIGNAL: a vanished peer is a failed write, not a SIGPIPE.
+inline bool writeAll(int fd, const void* buf, size_t len) {
+    const char* p = static_cast<const char*>(buf);
+    while (len > 0) {
+        ssize_t w = ::send(fd, p, len, MSG_NOSIGNAL);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        p += w;
+        len -= (size_t)w;
+    }
+    return true;
+}
+
+inline bool unixAddress(const std::string& path, sockaddr_un& addr) {
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Error: socket path too long: " << path << "\n";
+        return false;
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+inline sockaddr_in loopbackAddress(int port) {
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return addr;
+}
+
+} // namespace qsock_detail
+
+// Each connection has a reader thread, which decodes requests and submits
+// them to the router, and a writer thread. Router workers only append the
+// encoded response to the connection's outbox; the writer drains it, so a
+// client that stops reading blocks its own writer, never a router worker.
+// A request counts as in flight from the moment it is read until its
+// response has been written. At maxInFlight the reader stops reading, and
+// the socket buffers push back on the client. A connection is closed when
+// both threads and every pending response are done with it.
+template <typename PQType>
+class QuerySocketServer {
+public:
+    explicit QuerySocketServer(QueryRouter<PQType>& r, size_t maxInFlightPerConnection = 256)
+        : router(r), maxInFlight(maxInFlightPerConnection ? maxInFlightPerConnection : 1) {}
+    ~QuerySocketServer() { stop(); }
+
+    QuerySocketServer(const QuerySocketServer&) = delete;
+    QuerySocketServer& operator=(const QuerySocketServer&) = delete;
+
+    // 127.0.0.1:port; port 0 picks a free one (see port()).
+    bool listenTcp(int port) {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            std::cerr << "Error: socket: " << std::strerror(errno) << "\n";
+            return false;
+        }
+        int one = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr = qsock_detail::loopbackAddress(port);
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            std::cerr << "Error: bind 127.0.0.1:" << port << ": " << std::strerror(errno) << "\n";
+            ::close(fd);
+            return false;
+        }
+        socklen_t len = sizeof(addr);
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+        boundPort = ntohs(addr.sin_port);
+        isTcp = true;
+        return startListening(fd);
+    }
+
+    // Replaces any stale socket file at path; removed again by stop().
+    bool listenUnix(const std::string& path) {
+        sockaddr_un addr;
+        if (!qsock_detail::unixAddress(path, addr)) return false;
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            std::cerr << "Error: socket: " << std::strerror(errno) << "\n";
+            return false;
+        }
+        ::unlink(path.c_str());
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            std::cerr << "Error: bind " << path << ": " << std::strerror(errno) << "\n";
+            ::close(fd);
+            return false;
+        }
+        unixPath = path;
+        isTcp = false;
+        return startListening(fd);
+    }
+
+    int port() const { return boundPort; }
+    long long connectionsAccepted() const { return accepted.load(); }
+
+    // Stops accepting, disconnects every client and joins the threads.
+    // Responses still being computed are dropped.
+    void stop() {
+        if (listenFd < 0) return;
+        ::shutdown(listenFd, SHUT_RDWR);
+        if (acceptThread.joinable()) acceptThread.join();
+        ::close(listenFd);
+        listenFd = -1;
+        if (!unixPath.empty()) ::unlink(unixPath.c_str());
+
+        std::vector<Reader> stopped;
+        {
+            std::lock_guard<std::mutex> lk(connMtx);
+            for (auto& r : readers) {
+                if (auto c = r.conn.lock()) c->close();
+            }
+            stopped.swap(readers);
+        }
+        for (auto& r : stopped) r.thread.join();
+    }
+
+private:
+    struct Connection {
+        int fd;
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::deque<std::vector<unsigned char>> outbox; // encoded responses
+        size_t inFlight = 0;     // read, response not yet written
+        bool readerDone = false; // the client will send nothing more
+        bool closed = false;     // stop() or a failed write: drop everything
+
+        explicit Connection(int f) : fd(f) {}
+        ~Connection() { ::close(fd); }
+
+        void close() {
+            {
+                std::lock_guard<std::mutex> lk(mtx);
+                closed = true;
+                outbox.clear();
+            }
+            cv.notify_all();
+            ::shutdown(fd, SHUT_RDWR);
+        }
+    };
+
+    QueryRouter<PQType>& router;
+    size_t maxInFlight;
+    int listenFd = -1;
+    int boundPort = 0;
+    bool isTcp = false;
+    std::string unixPath;
+    std::thread acceptThread;
+    std::atomic<long long> accepted{0};
+
+    struct Reader {
+        std::thread thread;
+        std::weak_ptr<Connection> conn;
+        std::shared_ptr<std::atomic<bool>> finished;
+    };
+
+    std::mutex connMtx;
+    std::vector<Reader> readers;
+
+    bool startListening(int fd) {
+        if (::listen(fd, 128) != 0) {
+            std::cerr << "Error: listen: " << std::strerror(errno) << "\n";
+            ::close(fd);
+            return false;
+        }
+        listenFd = fd;
+        acceptThread = std::thread([this]() { acceptLoop(); });
+        return true;
+    }
+
+    void acceptLoop() {
+        while (true) {
+            int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) continue;
+                return; // shut down by stop()
+            }
+            if (isTcp) {
+                int one = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            }
+            accepted++;
+            auto conn = std::make_shared<Connection>(fd);
+            auto finished = std::make_shared<std::atomic<bool>>(false);
+            std::lock_guard<std::mutex> lk(connMtx);
+            reapReaders();
+            Reader r;
+            r.conn = conn;
+            r.finished = finished;
+            r.thread = std::thread([this, conn, finished]() mutable {
+                std::thread writer([this, conn]() { writeLoop(conn); });
+                readLoop(conn);
+                writer.join();
+                conn.reset();
+                finished->store(true);
+            });
+            readers.push_back(std::move(r));
+        }
+    }
+
+    // Joins the readers of closed connections. Requires connMtx.
+    void reapReaders() {
+        size_t keep = 0;
+        for (size_t i = 0; i < readers.size(); ++i) {
+            if (readers[i].finished->load()) {
+                readers[i].thread.join();
+            } else {
+                if (keep != i) readers[keep] = std::move(readers[i]);
+                ++keep;
+            }
+        }
+        readers.resize(keep);
+    }
+
+    void readLoop(const std::shared_ptr<Connection>& conn) {
+        unsigned char buf[WireRequest::Bytes];
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lk(conn->mtx);
+                conn->cv.wait(lk, [&]() { return conn->closed || conn->inFlight < maxInFlight; });
+                if (conn->closed) break;
+            }
+            if (!qsock_detail::readAll(conn->fd, buf, sizeof(buf))) break;
+            WireRequest req;
+            req.decode(buf);
+            {
+                std::lock_guard<std::mutex> lk(conn->mtx);
+                conn->inFlight++;
+            }
+            router.submit(req.source, req.target, (req.flags & WireRequest::WantPath) != 0,
+                          [conn, id = req.id](PathQueryResult&& res) {
+                              WireResponse resp;
+                              resp.id = id;
+                              resp.dist = res.dist;
+                              if (!res.valid) resp.status = QueryStatus::Invalid;
+                              else if (res.dist == std::numeric_limits<double>::infinity())
+                                  resp.status = QueryStatus::Unreachable;
+                              else resp.status = QueryStatus::Ok;
+                              resp.path.assign(res.path.begin(), res.path.end());
+                              std::vector<unsigned char> bytes;
+                              resp.encode(bytes);
+                              {
+                                  std::lock_guard<std::mutex> lk(conn->mtx);
+                                  if (conn->closed) return;
+                                  conn->outbox.push_back(std::move(bytes));
+                              }
+                              conn->cv.notify_all();
+                          });
+        }
+        {
+            std::lock_guard<std::mutex> lk(conn->mtx);
+            conn->readerDone = true;
+        }
+        conn->cv.notify_all();
+    }
+
+    // Writes queued responses, several per send() when they pile up. Ends
+    // once the reader is done and every response is out, or on close.
+    void writeLoop(const std::shared_ptr<Connection>& conn) {
+        std::deque<std::vector<unsigned char>> batch;
+        std::vector<unsigned char> bytes;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lk(conn->mtx);
+                conn->cv.wait(lk, [&]() {
+                    return conn->closed || !conn->outbox.empty()
+                        || (conn->readerDone && conn->inFlight == 0);
+                });
+                if (conn->closed || conn->outbox.empty()) return;
+                batch.swap(conn->outbox);
+            }
+            bytes.clear();
+            for (const auto& b : batch) bytes.insert(bytes.end(), b.begin(), b.end());
+            if (!qsock_detail::writeAll(conn->fd, bytes.data(), bytes.size())) {
+                conn->close();
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lk(conn->mtx);
+                conn->inFlight -= batch.size();
+            }
+            conn->cv.notify_all();
+            batch.clear();
+        }
+    }
+};
+
+// Blocking client for one connection. send() and receive() may be
+// interleaved freely to keep several requests in flight.
+class QuerySocketClient {
+public:
+    QuerySocketClient() = default;
+    ~QuerySocketClient() { close(); }
+
+    QuerySocketClient(const QuerySocketClient&) = delete;
+    QuerySocketClient& operator=(const QuerySocketClient&) = delete;
+
+    bool connectTcp(int port) {
+        close();
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) return fail("socket");
+        sockaddr_in addr = qsock_detail::loopbackAddress(port);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            return fail("connect");
+        }
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        return true;
+    }
+
+    bool connectUnix(const std::string& path) {
+        close();
+        sockaddr_un addr;
+        if (!qsock_detail::unixAddress(path, addr)) return false;
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return fail("socket");
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            return fail("connect");
+        }
+        return true;
+    }
+
+    bool send(const WireRequest& req) {
+        unsigned char buf[WireRequest::Bytes];
+        req.encode(buf);
+        return qsock_detail::writeAll(fd, buf, sizeof(buf));
+    }
+
+    bool receive(WireResponse& resp) {
+        unsigned char head[WireResponse::HeaderBytes];
+        if (!qsock_detail::readAll(fd, head, sizeof(head))) return false;
+        uint32_t len = resp.decodeHeader(head);
+        resp.path.resize(len);
+        return len == 0 || qsock_detail::readAll(fd, resp.path.data(), (size_t)len * 4);
+    }
+
+    void close() {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+
+private:
+    int fd = -1;
+
+    bool fail(const char* what) {
+        std::cerr << "Error: " << what << ": " << std::strerror(errno) << "\n";
+        close();
+        return false;
+    }
+};
+
+#endif // QUERY_SOCKET_H
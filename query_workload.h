@@ -0,0 +1,228 @@
+// query_workload.h
+#ifndef QUERY_WORKLOAD_H
+#define QUERY_WORKLOAD_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <unordered_set>
+#include "graph.h"
+#include "dijkstra.h"
+#include "binary_heap.h"
+#include "graph_generators.h"
+
+// Source/target query sets for point-to-point benchmarks.
+//
+// Dijkstra-rank queries follow the usual road-network methodology: from a
+// random source s, the target for rank 2^i is the 2^i-th vertex Dijkstra
+// settles, so the results can be plotted against query "difficulty" instead
+// of averaged over mostly long queries. Uniform pairs and local/long-range
+// mixes are also available. Everything is driven by one seed (SplitMix64),
+// and a workload can be saved and loaded so every heap and engine is run on
+// the same queries.
+
+struct Query {
+    int source;
+    int target;
+    long long rank; // Dijkstra rank of target from source, -1 if not computed
+};
+
+struct QueryWorkload {
+    std::string kind;          // "rank", "random", "mixed"
+    uint64_t seed = 0;
+    int numGraphVertices = 0;
+    std::vector<Query> queries;
+
+    size_t size() const { return queries.size(); }
+
+    // Distinct sources, in first-use order (for single-source drivers).
+    std::vector<int> sources() const {
+        std::vector<int> out;
+        std::unordered_set<int> seen;
+        for (const auto& q : queries) {
+            if (seen.insert(q.source).second) out.push_back(q.source);
+        }
+        return out;
+    }
+
+    // Text format:
+    //   # QWL1 <kind> <seed> <numGraphVertices> <numQueries>
+    //   source target rank      (one line per query)
+    bool save(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out.is_open()) {
+            std::cerr << "Error: cannot open file " << path << std::endl;
+            return false;
+        }
+        out << "# QWL1 " << kind << " " << seed << " " << numGraphVertices << " "
+            << queries.size() << "\n";
+        for (const auto& q : queries) {
+            out << q.source << " " << q.target << " " << q.rank << "\n";
+        }
+        return (bool)out;
+    }
+
+    bool load(const std::string& path) {
+        std::ifstream in(path);
+        if (!in.is_open()) {
+            std::cerr << "Error: cannot open file " << path << std::endl;
+            return false;
+        }
+        std::string line;
+        std::string magic, hash;
+        size_t count = 0;
+        if (!std::getline(in, line)) {
+            std::cerr << "Error: " << path << " is empty" << std::endl;
+            return false;
+        }
+        std::istringstream header(line);
+        header >> hash >> magic >> kind >> seed >> numGraphVertices >> count;
+        if (hash != "#" || magic != "QWL1" || !header) {
+            std::cerr << "Error: " << path << " is not a query workload" << std::endl;
+            return false;
+        }
+        queries.clear();
+        // count comes from the file; the size check below catches a wrong one.
+        queries.reserve(std::min<size_t>(count, 1 << 20));
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream iss(line);
+            Query q;
+            if (!(iss >> q.source >> q.target >> q.rank)) continue;
+            queries.push_back(q);
+        }
+        if (queries.size() != count) {
+            std::cerr << "Error: truncated workload " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // False if any query names a vertex outside g (workload made for another graph).
+    bool fits(const Graph& g) const {
+        for (const auto& q : queries) {
+            if (q.source < 0 || q.source >= g.numVertices()) return false;
+            if (q.target < 0 || q.target >= g.numVertices()) return false;
+        }
+        return true;
+    }
+};
+
+// Settle order from source, stopping after `limit` vertices. order[r] is the
+// vertex of Dijkstra rank r (order[0] == source).
+inline void dijkstraSettleOrder(const Graph& g, int source, long long limit,
+                                DijkstraWorkspace& ws, std::vector<int>& order) {
+    ws.prepare(g.numVertices());
+    order.clear();
+    BinaryHeap pq;
+    ws.dist[source] = 0.0;
+    ws.touch(source);
+    ws.handles[source] = pq.insert(0.0, source);
+    while (!pq.empty() && (long long)order.size() < limit) {
+        auto [d, u] = pq.extract_min();
+        if (d > ws.dist[u]) continue;
+        order.push_back(u);
+        for (const auto& e : g.neighbors(u)) {
+            int v = e.to;
+            double nd = d + e.weight;
+            if (nd < ws.dist[v]) {
+                ws.dist[v] = nd;
+                if (ws.handles[v] == nullptr) {
+                    ws.touch(v);
+                    ws.handles[v] = pq.insert(nd, v);
+                } else {
+                    pq.decrease_key(ws.handles[v], nd);
+                }
+            }
+        }
+    }
+}
+
+// For each of numSources random sources, one query per rank 2^minLog ..
+// 2^maxLog that the source's component is large enough for. maxLog < 0
+// means "up to the largest power of two below n"; ranks are clamped to
+// 2^0 .. 2^62.
+inline QueryWorkload generateRankQueries(const Graph& g, int numSources, uint64_t seed,
+                                         int minLog = 1, int maxLog = -1) {
+    QueryWorkload w;
+    w.kind = "rank";
+    w.seed = seed;
+    w.numGraphVertices = g.numVertices();
+    int n = g.numVertices();
+    if (n <= 0) return w;
+    if (maxLog < 0) {
+        maxLog = 0;
+        while ((2ll << maxLog) < n) ++maxLog;
+    }
+    minLog = std::max(minLog, 0);
+    maxLog = std::min(maxLog, 62);
+    long long limit = std::min<long long>(n, (1ll << maxLog) + 1);
+
+    SplitMix64 rng(seed);
+    DijkstraWorkspace ws;
+    std::vector<int> order;
+    for (int i = 0; i < numSources; ++i) {
+        int s = (int)rng.below((uint64_t)n);
+        dijkstraSettleOrder(g, s, limit, ws, order);
+        for (int lg = minLog; lg <= maxLog; ++lg) {
+            long long r = 1ll << lg;
+            if (r >= (long long)order.size()) break;
+            w.queries.push_back({s, order[r], r});
+        }
+    }
+    return w;
+}
+
+// count uniformly random (source, target) pairs. Mostly long-range on any
+// large graph, which is exactly why they should not be the only workload.
+inline QueryWorkload generateRandomPairs(const Graph& g, int count, uint64_t seed) {
+    QueryWorkload w;
+    w.kind = "random";
+    w.seed = seed;
+    w.numGraphVertices = g.numVertices();
+    int n = g.numVertices();
+    if (n <= 0) return w;
+    SplitMix64 rng(seed);
+    for (int i = 0; i < count; ++i) {
+        int s = (int)rng.below((uint64_t)n);
+        int t = (int)rng.below((uint64_t)n);
+        w.queries.push_back({s, t, -1});
+    }
+    return w;
+}
+
+// A fraction localFraction of the queries go to a target drawn uniformly
+// from the first localRank vertices settled from the source (a trip across
+// town); the rest are uniform random pairs (long-range).
+inline QueryWorkload generateMixedQueries(const Graph& g, int count, double localFraction,
+                                          long long localRank, uint64_t seed) {
+    QueryWorkload w;
+    w.kind = "mixed";
+    w.seed = seed;
+    w.numGraphVertices = g.numVertices();
+    int n = g.numVertices();
+    if (n <= 0) return w;
+    SplitMix64 rng(seed);
+    DijkstraWorkspace ws;
+    std::vector<int> order;
+    for (int i = 0; i < count; ++i) {
+        int s = (int)rng.below((uint64_t)n);
+        if (rng.uniform() < localFraction) {
+            dijkstraSettleOrder(g, s, localRank + 1, ws, order);
+            if (order.size() > 1) {
+                long long r = 1 + (long long)rng.below(order.size() - 1);
+                w.queries.push_back({s, order[r], r});
+                continue;
+            }
+        }
+        int t = (int)rng.below((uint64_t)n);
+        w.queries.push_back({s, t, -1});
+    }
+    return w;
+}
+
+#endif // QUERY_WORKLOAD_H
@@ -0,0 +1,249 @@
+// rank_pairing_heap.h
+#ifndef RANK_PAIRING_HEAP_H
+#define RANK_PAIRING_HEAP_H
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "priority_queue.h"
+#include "node_pool.h"
+
+// Rank-pairing heap (Haeupler, Sen & Tarjan, 2011) with one-pass linking.
+// Same amortized bounds as FibonacciHeap (O(1) insert / decrease-key,
+// O(log n) extract-min) but decrease-key never cascades cuts: it cuts one
+// node and lowers ranks along a single path, stopping as soon as a rank
+// does not change.
+//
+// Every tree is a half tree in binary (left-child / right-sibling) form:
+// a root has only a left child, and each node's key is <= the keys in its
+// left subtree. RankRule selects how ranks are restored after a cut:
+//   1 (type-1): children ranks r1, r2 -> r1 == r2 ? r1 + 1 : max(r1, r2)
+//   2 (type-2): |r1 - r2| <= 1 ? max(r1, r2) + 1 : max(r1, r2)
+// Type-2 is the relaxed rule: fewer rank changes, same bounds.
+
+class RankPairingNode : public PQNodeBase {
+public:
+    double key;
+    int value;
+    int rank;
+    bool inHeap;
+    RankPairingNode* left;
+    RankPairingNode* right;
+    RankPairingNode* parent; // binary-tree parent; nullptr for roots
+    RankPairingNode* next;   // root list
+
+    RankPairingNode(double k, int v)
+        : key(k), value(v), rank(0), inHeap(true),
+          left(nullptr), right(nullptr), parent(nullptr), next(nullptr) {}
+};
+
+template <int RankRule>
+class RankPairingHeapT : public PriorityQueue {
+    static_assert(RankRule == 1 || RankRule == 2, "rank-pairing heaps are type-1 or type-2");
+
+public:
+    RankPairingHeapT()
+        : roots(nullptr), minNode(nullptr), nNodes(0), nRoots(0),
+          maxRootRank(0), rankReductions(0) {}
+
+    ~RankPairingHeapT() override = default;
+
+    PQNodeBase* insert(double key, int value) override {
+        RankPairingNode* x = pool.create(key, value);
+        addRoot(x);
+        ++nNodes;
+        return x;
+    }
+
+    bool empty() const override {
+        return minNode == nullptr;
+    }
+
+    std::pair<double,int> find_min() const override {
+        if (!minNode) return {std::numeric_limits<double>::infinity(), -1};
+        return {minNode->key, minNode->value};
+    }
+
+    std::pair<double,int> extract_min() override {
+        if (!minNode) {
+            return {std::numeric_limits<double>::infinity(), -1};
+        }
+        RankPairingNode* z = minNode;
+        std::pair<double,int> res = {z->key, z->value};
+
+        // Every other root, then the right spine of z's left child, which
+        // falls apart into half trees.
+        pending.clear();
+        for (RankPairingNode* r = roots; r != nullptr; r = r->next) {
+            if (r != z) pending.push_back(r);
+        }
+        RankPairingNode* x = z->left;
+        while (x != nullptr) {
+            RankPairingNode* nx = x->right;
+            x->right = nullptr;
+            x->parent = nullptr;
+            x->rank = rootRank(x);
+            pending.push_back(x);
+            x = nx;
+        }
+
+        z->inHeap = false;
+        z->left = nullptr;
+        --nNodes;
+
+        // One-pass linking: each pair of equal-rank trees is linked once and
+        // the result goes straight to the output, not back into a bucket.
+        roots = nullptr;
+        minNode = nullptr;
+        nRoots = 0;
+        maxRootRank = 0;
+        if (buckets.size() < 8) buckets.assign(8, nullptr);
+        for (RankPairingNode* t : pending) {
+            t->next = nullptr;
+            if ((size_t)t->rank >= buckets.size()) buckets.resize(t->rank + 1, nullptr);
+            RankPairingNode*& slot = buckets[t->rank];
+            if (slot == nullptr) {
+                slot = t;
+            } else {
+                RankPairingNode* other = slot;
+                slot = nullptr;
+                pushRoot(link(t, other));
+            }
+        }
+        for (auto& slot : buckets) {
+            if (slot != nullptr) {
+                pushRoot(slot);
+                slot = nullptr;
+            }
+        }
+        return res;
+    }
+
+    void decrease_key(PQNodeBase* n, double new_key) override {
+        auto* x = dynamic_cast<RankPairingNode*>(n);
+        if (!x || !x->inHeap) return;
+        if (new_key >= x->key) return;
+        x->key = new_key;
+
+        if (x->parent == nullptr) {
+            // already a root
+            if (x->key < minNode->key) minNode = x;
+            return;
+        }
+
+        // Cut x with its left subtree; its right subtree takes its place.
+        RankPairingNode* p = x->parent;
+        RankPairingNode* y = x->right;
+        if (p->left == x) p->left = y;
+        else p->right = y;
+        if (y) y->parent = p;
+        x->right = nullptr;
+        x->parent = nullptr;
+        x->rank = rootRank(x);
+        addRoot(x);
+
+        // Restore the rank rule on the path above the cut.
+        RankPairingNode* u = p;
+        while (u->parent != nullptr) {
+            int k = ruleRank(rankOf(u->left), rankOf(u->right));
+            if (k >= u->rank) return;
+            u->rank = k;
+            ++rankReductions;
+            u = u->parent;
+        }
+        int k = rootRank(u);
+        if (k < u->rank) {
+            u->rank = k;
+            ++rankReductions;
+        }
+    }
+
+    void remove(PQNodeBase* n) override {
+        decrease_key(n, -std::numeric_limits<double>::infinity());
+        extract_min();
+    }
+
+    int getSize() const override {
+        return (int)nNodes;
+    }
+
+    // Half-tree rank bounds the height of each tree's heap order; reported
+    // as the largest root rank + 1, as of the last extract-min.
+    int getHeightEstimate() const override {
+        return nNodes == 0 ? 0 : maxRootRank + 1;
+    }
+
+    int getNumTrees() const override {
+        return nRoots;
+    }
+
+    // No cascading cuts in an rp-heap; this counts the rank reductions that
+    // decrease-key performs instead, the analogous amortized work.
+    long long getNumCascadingCuts() const override {
+        return rankReductions;
+    }
+
+    double getMemoryUsageMBEstimate() const override {
+        double bytes = sizeof(*this) + pool.bytesReserved()
+                     + pending.capacity() * sizeof(RankPairingNode*)
+                     + buckets.capacity() * sizeof(RankPairingNode*);
+        return bytes / (1024.0 * 1024.0);
+    }
+
+private:
+    NodePool<RankPairingNode> pool;
+    RankPairingNode* roots;   // singly linked through next
+    RankPairingNode* minNode;
+    size_t nNodes;
+    int nRoots;
+    int maxRootRank;
+    long long rankReductions;
+    std::vector<RankPairingNode*> pending; // scratch for extract_min
+    std::vector<RankPairingNode*> buckets; // scratch, indexed by rank
+
+    static int rankOf(const RankPairingNode* x) {
+        return x ? x->rank : -1;
+    }
+
+    static int rootRank(const RankPairingNode* x) {
+        return rankOf(x->left) + 1;
+    }
+
+    static int ruleRank(int r1, int r2) {
+        int hi = std::max(r1, r2);
+        if (RankRule == 1) {
+            return r1 == r2 ? r1 + 1 : hi;
+        }
+        int diff = r1 > r2 ? r1 - r2 : r2 - r1;
+        return diff <= 1 ? hi + 1 : hi;
+    }
+
+    void addRoot(RankPairingNode* x) {
+        x->next = roots;
+        roots = x;
+        ++nRoots;
+        if (!minNode || x->key < minNode->key) minNode = x;
+    }
+
+    void pushRoot(RankPairingNode* x) {
+        addRoot(x);
+        maxRootRank = std::max(maxRootRank, x->rank);
+    }
+
+    // Links two half trees of equal rank; the loser becomes the winner's
+    // left child and takes the winner's old left subtree as its right one.
+    static RankPairingNode* link(RankPairingNode* a, RankPairingNode* b) {
+        if (b->key < a->key) std::swap(a, b);
+        b->right = a->left;
+        if (b->right) b->right->parent = b;
+        b->parent = a;
+        a->left = b;
+        a->rank = b->rank + 1;
+        return a;
+    }
+};
+
+using RankPairingHeap1 = RankPairingHeapT<1>;
+using RankPairingHeap2 = RankPairingHeapT<2>;
+
+#endif // RANK_PAIRING_HEAP_H
@@ -0,0 +1,349 @@
+// sequence_heap.h
+#ifndef SEQUENCE_HEAP_H
+#define SEQUENCE_HEAP_H
+
+#include <vector>
+#include <memory>
+#include <cstdio>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <utility>
+#include "lazy_heap.h"
+#include "memory_tracker.h"
+
+struct SequenceHeapOptions {
+    size_t insertCapacity = 256;      // insertion heap, entries (L1-sized)
+    size_t deleteCapacity = 256;      // deletion buffer, entries
+    size_t mergeArity = 16;           // runs per group before they are merged
+    size_t memoryBudgetBytes = 0;     // 0: unlimited, never spill
+    size_t spillBlockEntries = 1024;  // I/O block of a spilled run
+};
+
+// Sequence heap after Sanders ("Fast priority queues for cached memory",
+// 1999), for frontiers too large for a pointer heap. Same interface and
+// lazy-deletion use as LazyDAryHeap (runDijkstraLazy); there is no
+// decrease_key.
+//
+//   insertion heap   new entries land in a small LazyQuaternaryHeap; when
+//                    it is full it is sorted, together with what is left
+//                    of the deletion buffer, into a run in group 0
+//   groups           group g holds up to mergeArity sorted runs of roughly
+//                    insertCapacity * mergeArity^g entries; a full group is
+//                    k-way merged into a single run of group g + 1
+//   deletion buffer  the smallest deleteCapacity entries of all runs,
+//                    refilled by a k-way merge of the run heads
+//
+// Every entry in a run is >= every entry in the deletion buffer, so the
+// minimum is the smaller of the deletion buffer front and the insertion
+// heap top.
+//
+// With a memory budget, a new run that would push the in-memory runs over
+// the budget is written to an anonymous temporary file (std::tmpfile) and
+// read back one block at a time while it is merged. The file is removed
+// when the run is used up. The budget is approximate: it covers the
+// buffers and run storage, not the bookkeeping.
+class SequenceHeap {
+public:
+    using Entry = LazyQuaternaryHeap::Entry;
+
+    explicit SequenceHeap(const SequenceHeapOptions& options = SequenceHeapOptions())
+        : opt(options) {
+        if (opt.insertCapacity < 1) opt.insertCapacity = 1;
+        if (opt.deleteCapacity < 1) opt.deleteCapacity = 1;
+        if (opt.mergeArity < 2) opt.mergeArity = 2;
+        if (opt.spillBlockEntries < 1) opt.spillBlockEntries = 1;
+        ins.reserve(opt.insertCapacity);
+        del.reserve(opt.deleteCapacity);
+    }
+
+    ~SequenceHeap() = default;
+
+    SequenceHeap(const SequenceHeap&) = delete;
+    SequenceHeap& operator=(const SequenceHeap&) = delete;
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    void clear() {
+        ins.clear();
+        del.clear();
+        delPos = 0;
+        for (auto& group : groups) {
+            for (auto& run : group) releaseRun(run);
+        }
+        groups.clear();
+        count = 0;
+    }
+
+    void push(double key, int value) {
+        if (ins.size() >= opt.insertCapacity) flushInsertHeap();
+        ins.push(key, value);
+        ++count;
+    }
+
+    // Not const: may refill the deletion buffer. Requires !empty().
+    const Entry& top() {
+        if (delPos == del.size()) refill();
+        if (!ins.empty() && (delPos == del.size() || ins.top().key < del[delPos].key)) {
+            return ins.top();
+        }
+        return del[delPos];
+    }
+
+    // Requires !empty().
+    Entry pop() {
+        if (delPos == del.size()) refill();
+        --count;
+        if (!ins.empty() && (delPos == del.size() || ins.top().key < del[delPos].key)) {
+            return ins.pop();
+        }
+        return del[delPos++];
+    }
+
+    size_t numRuns() const {
+        size_t r = 0;
+        for (const auto& group : groups) r += group.size();
+        return r;
+    }
+    size_t numGroups() const { return groups.size(); }
+    long long spilledRuns() const { return runsSpilled; }
+    long long spilledEntries() const { return entriesSpilled; }
+
+    double getMemoryUsageMBEstimate() const {
+        double bytes = sizeof(*this) + ins.getMemoryUsageMBEstimate() * 1024.0 * 1024.0
+                     + (del.capacity() + scratch.capacity()) * sizeof(Entry);
+        for (const auto& group : groups) {
+            for (const auto& run : group) bytes += run->buf.capacity() * sizeof(Entry);
+        }
+        return bytes / (1024.0 * 1024.0);
+    }
+
+private:
+    struct Run {
+        // The whole run, or the current block of a spilled one.
+        TrackedVector<Entry, MemComponent::HeapStructure> buf;
+        size_t pos = 0;
+        std::FILE* file = nullptr; // spilled runs only
+        size_t unread = 0;         // entries still in the file
+        size_t charged = 0;        // entries counted against the budget
+
+        Run() = default;
+        Run(const Run&) = delete;
+        Run& operator=(const Run&) = delete;
+        ~Run() {
+            if (file) std::fclose(file);
+        }
+
+        const Entry& head() const { return buf[pos]; }
+        bool exhausted() const { return pos == buf.size() && unread == 0; }
+        size_t remaining() const { return buf.size() - pos + unread; }
+    };
+    using RunPtr = std::unique_ptr<Run>;
+
+    SequenceHeapOptions opt;
+    LazyQuaternaryHeap ins;
+    TrackedVector<Entry, MemComponent::HeapStructure> del; // sorted
+    size_t delPos = 0;
+    std::vector<std::vector<RunPtr>> groups;
+    size_t count = 0;
+    size_t inMemoryEntries = 0; // run storage counted against the budget
+    long long runsSpilled = 0;
+    long long entriesSpilled = 0;
+    bool spillFailed = false;
+    TrackedVector<Entry, MemComponent::HeapStructure> scratch;
+
+    // k-way merge state: (key, run index), smallest key on top.
+    using HeadItem = std::pair<double, size_t>;
+    std::vector<HeadItem> heads;
+
+    void releaseRun(RunPtr& run) {
+        inMemoryEntries -= run->charged;
+        run.reset();
+    }
+
+    bool shouldSpill(size_t len) const {
+        if (opt.memoryBudgetBytes == 0 || spillFailed) return false;
+        size_t budget = opt.memoryBudgetBytes / sizeof(Entry);
+        size_t fixed = opt.insertCapacity + opt.deleteCapacity
+                     + (numRuns() + 1) * opt.spillBlockEntries;
+        return fixed + inMemoryEntries + len > budget;
+    }
+
+    // A run of len entries, in memory or backed by a temporary file.
+    RunPtr beginRun(size_t len) {
+        RunPtr run(new Run());
+        if (shouldSpill(len)) {
+            run->file = std::tmpfile();
+            if (!run->file) {
+                std::cerr << "Error: could not create a spill file; "
+                          << "sequence heap runs stay in memory\n";
+                spillFailed = true;
+            }
+        }
+        if (run->file) {
+            run->buf.reserve(opt.spillBlockEntries);
+            ++runsSpilled;
+            entriesSpilled += (long long)len;
+        } else {
+            run->buf.reserve(len);
+            run->charged = len;
+            inMemoryEntries += len;
+        }
+        return run;
+    }
+
+    void append(Run& run, const Entry& e) {
+        run.buf.push_back(e);
+        if (run.file && run.buf.size() == opt.spillBlockEntries) writeBlock(run);
+    }
+
+    void finishRun(Run& run) {
+        if (!run.file) return;
+        writeBlock(run);
+        std::rewind(run.file);
+        readBlock(run);
+    }
+
+    void writeBlock(Run& run) {
+        if (run.buf.empty()) return;
+        size_t n = std::fwrite(run.buf.data(), sizeof(Entry), run.buf.size(), run.file);
+        if (n != run.buf.size()) {
+            std::cerr << "Error: short write to sequence heap spill file\n";
+        }
+        run.unread += n;
+        run.buf.clear();
+    }
+
+    void readBlock(Run& run) {
+        size_t want = std::min(run.unread, opt.spillBlockEntries);
+        run.buf.resize(want);
+        size_t n = std::fread(run.buf.data(), sizeof(Entry), want, run.file);
+        if (n != want) {
+            std::cerr << "Error: short read from sequence heap spill file\n";
+            run.buf.resize(n);
+            run.unread = 0;
+        } else {
+            run.unread -= want;
+        }
+        run.pos = 0;
+    }
+
+    void advance(Run& run) {
+        ++run.pos;
+        if (run.pos == run.buf.size() && run.unread > 0) readBlock(run);
+    }
+
+    // Sorts the insertion heap and the rest of the deletion buffer into one
+    // run in group 0. Taking the deletion buffer along keeps every run >=
+    // every buffered entry.
+    void flushInsertHeap() {
+        scratch.clear();
+        while (!ins.empty()) scratch.push_back(ins.pop());
+        size_t len = scratch.size() + (del.size() - delPos);
+        RunPtr run = beginRun(len);
+        size_t i = 0;
+        while (i < scratch.size() || delPos < del.size()) {
+            if (delPos == del.size() || (i < scratch.size() && scratch[i].key < del[delPos].key)) {
+                append(*run, scratch[i++]);
+            } else {
+                append(*run, del[delPos++]);
+            }
+        }
+        del.clear();
+        delPos = 0;
+        finishRun(*run);
+        addRun(0, std::move(run));
+    }
+
+    void addRun(size_t g, RunPtr run) {
+        if (groups.size() <= g) groups.resize(g + 1);
+        groups[g].push_back(std::move(run));
+        if (groups[g].size() >= opt.mergeArity) {
+            RunPtr merged = mergeGroup(groups[g]);
+            groups[g].clear();
+            addRun(g + 1, std::move(merged));
+        }
+    }
+
+    RunPtr mergeGroup(std::vector<RunPtr>& runs) {
+        std::vector<Run*> src;
+        size_t len = 0;
+        for (auto& r : runs) {
+            src.push_back(r.get());
+            len += r->remaining();
+            // the inputs drain as the output fills
+            inMemoryEntries -= r->charged;
+            r->charged = 0;
+        }
+        RunPtr out = beginRun(len);
+        startMerge(src);
+        Entry e;
+        while (nextMerged(src, e)) append(*out, e);
+        for (auto& r : runs) releaseRun(r);
+        finishRun(*out);
+        return out;
+    }
+
+    // Refills the deletion buffer with the smallest entries over all runs
+    // and drops the runs that ran dry.
+    void refill() {
+        del.clear();
+        delPos = 0;
+        std::vector<Run*> src;
+        for (auto& group : groups) {
+            for (auto& r : group) src.push_back(r.get());
+        }
+        if (src.empty()) return;
+        startMerge(src);
+        Entry e;
+        while (del.size() < opt.deleteCapacity && nextMerged(src, e)) del.push_back(e);
+        for (auto& group : groups) {
+            for (auto& r : group) {
+                if (r->exhausted()) releaseRun(r);
+            }
+            group.erase(std::remove(group.begin(), group.end(), nullptr), group.end());
+        }
+        while (!groups.empty() && groups.back().empty()) groups.pop_back();
+    }
+
+    void startMerge(const std::vector<Run*>& src) {
+        heads.clear();
+        for (size_t i = 0; i < src.size(); ++i) {
+            if (!src[i]->exhausted()) heads.emplace_back(src[i]->head().key, i);
+        }
+        std::make_heap(heads.begin(), heads.end(), std::greater<HeadItem>());
+    }
+
+    bool nextMerged(const std::vector<Run*>& src, Entry& out) {
+        if (heads.empty()) return false;
+        std::pop_heap(heads.begin(), heads.end(), std::greater<HeadItem>());
+        size_t idx = heads.back().second;
+        heads.pop_back();
+        Run& run = *src[idx];
+        out = run.head();
+        advance(run);
+        if (!run.exhausted()) {
+            heads.emplace_back(run.head().key, idx);
+            std::push_heap(heads.begin(), heads.end(), std::greater<HeadItem>());
+        }
+        return true;
+    }
+};
+
+// SequenceHeap that keeps about 1 MiB in memory and spills larger runs to
+// temporary files; default-constructible so it can be registered.
+class SpillingSequenceHeap : public SequenceHeap {
+public:
+    SpillingSequenceHeap() : SequenceHeap(options()) {}
+
+private:
+    static SequenceHeapOptions options() {
+        SequenceHeapOptions o;
+        o.memoryBudgetBytes = 1 << 20;
+        return o;
+    }
+};
+
+#endif // SEQUENCE_HEAP_H
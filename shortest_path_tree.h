@@ -0,0 +1,244 @@
+// shortest_path_tree.h
+#ifndef SHORTEST_PATH_TREE_H
+#define SHORTEST_PATH_TREE_H
+
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include "graph.h"
+#include "priority_queue.h"
+#include "dijkstra.h"
+
+// Sparse shortest-path tree: only settled vertices, in settle order.
+// Parents are stored as positions in that order, so walking a path back to
+// the source never needs a dense per-vertex array. DistT can be float to
+// halve the distance storage when centimetre precision is not needed.
+template <typename DistT = double>
+struct ShortestPathTree {
+    int source = -1;
+    int numGraphVertices = 0;
+    std::vector<int> vertices;   // settle order, vertices[0] == source
+    std::vector<int> parentIdx;  // index into vertices, -1 for the source
+    std::vector<DistT> dist;     // dist[i] belongs to vertices[i]
+    std::vector<int> byVertex;   // indices sorted by vertex id, for lookups
+
+    int size() const { return (int)vertices.size(); }
+
+    // Position of v in settle order, or -1 if v was not settled. O(log k).
+    int indexOf(int v) const {
+        auto it = std::lower_bound(byVertex.begin(), byVertex.end(), v,
+            [this](int idx, int key) { return vertices[idx] < key; });
+        if (it == byVertex.end() || vertices[*it] != v) return -1;
+        return *it;
+    }
+
+    bool reached(int v) const { return indexOf(v) >= 0; }
+
+    DistT distanceTo(int v) const {
+        int i = indexOf(v);
+        return i < 0 ? std::numeric_limits<DistT>::infinity() : dist[i];
+    }
+
+    // Vertices from source to target; empty if target was not settled.
+    std::vector<int> pathTo(int target) const {
+        return pathToIndex(indexOf(target));
+    }
+
+    // O(path length) once the settle position is known.
+    std::vector<int> pathToIndex(int idx) const {
+        std::vector<int> path;
+        for (int i = idx; i >= 0; i = parentIdx[i]) {
+            path.push_back(vertices[i]);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    void buildLookup() {
+        byVertex.resize(vertices.size());
+        for (size_t i = 0; i < byVertex.size(); ++i) byVertex[i] = (int)i;
+        std::sort(byVertex.begin(), byVertex.end(),
+            [this](int a, int b) { return vertices[a] < vertices[b]; });
+    }
+
+    // Expand back to the dense form used by the rest of the code.
+    DijkstraResult toDense() const {
+        DijkstraResult res{
+            DijkstraBuffer<double>(numGraphVertices, std::numeric_limits<double>::infinity()),
+            DijkstraBuffer<int>(numGraphVertices, -1)};
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            res.dist[vertices[i]] = (double)dist[i];
+            res.parent[vertices[i]] = parentIdx[i] < 0 ? -1 : vertices[parentIdx[i]];
+        }
+        return res;
+    }
+
+    size_t memoryBytes() const {
+        return sizeof(*this)
+             + vertices.capacity() * sizeof(int)
+             + parentIdx.capacity() * sizeof(int)
+             + dist.capacity() * sizeof(DistT)
+             + byVertex.capacity() * sizeof(int);
+    }
+
+    // --- Binary blob ---
+    // Layout (host byte order):
+    //   "SPT1" | u8 sizeof(DistT) | i32 source | i32 numGraphVertices |
+    //   u32 count | i32 vertices[count] | i32 parentIdx[count] | DistT dist[count]
+    // The lookup index is rebuilt on load rather than stored.
+
+    std::vector<unsigned char> serialize() const {
+        uint32_t count = (uint32_t)vertices.size();
+        std::vector<unsigned char> blob;
+        blob.reserve(17 + (size_t)count * (2 * sizeof(int32_t) + sizeof(DistT)));
+        const char magic[4] = {'S', 'P', 'T', '1'};
+        append(blob, magic, 4);
+        unsigned char distSize = (unsigned char)sizeof(DistT);
+        append(blob, &distSize, 1);
+        int32_t src = source, nv = numGraphVertices;
+        append(blob, &src, sizeof(src));
+        append(blob, &nv, sizeof(nv));
+        append(blob, &count, sizeof(count));
+        append(blob, vertices.data(), count * sizeof(int32_t));
+        append(blob, parentIdx.data(), count * sizeof(int32_t));
+        append(blob, dist.data(), count * sizeof(DistT));
+        return blob;
+    }
+
+    bool deserialize(const std::vector<unsigned char>& blob) {
+        size_t pos = 0;
+        char magic[4];
+        unsigned char distSize = 0;
+        int32_t src = 0, nv = 0;
+        uint32_t count = 0;
+        if (!read(blob, pos, magic, 4) || std::memcmp(magic, "SPT1", 4) != 0) {
+            std::cerr << "Error: not a shortest-path tree blob" << std::endl;
+            return false;
+        }
+        if (!read(blob, pos, &distSize, 1) || distSize != sizeof(DistT)) {
+            std::cerr << "Error: tree blob distance width mismatch" << std::endl;
+            return false;
+        }
+        if (!read(blob, pos, &src, sizeof(src)) || !read(blob, pos, &nv, sizeof(nv))
+            || !read(blob, pos, &count, sizeof(count))) {
+            std::cerr << "Error: truncated tree blob" << std::endl;
+            return false;
+        }
+        if ((size_t)count > (blob.size() - pos) / (2 * sizeof(int32_t) + sizeof(DistT))) {
+            std::cerr << "Error: truncated tree blob" << std::endl;
+            return false;
+        }
+        std::vector<int> vs(count), ps(count);
+        std::vector<DistT> ds(count);
+        read(blob, pos, vs.data(), count * sizeof(int32_t));
+        read(blob, pos, ps.data(), count * sizeof(int32_t));
+        read(blob, pos, ds.data(), count * sizeof(DistT));
+
+        // Parents must point to earlier entries, so pathToIndex() ends at the
+        // source, and every vertex must exist for toDense().
+        bool valid = nv >= 0 && (count == 0 || vs[0] == src);
+        for (uint32_t i = 0; i < count && valid; ++i) {
+            valid = vs[i] >= 0 && vs[i] < nv
+                 && (i == 0 ? ps[i] == -1 : ps[i] >= 0 && ps[i] < (int)i);
+        }
+        if (!valid) {
+            std::cerr << "Error: corrupt tree blob" << std::endl;
+            return false;
+        }
+        source = src;
+        numGraphVertices = nv;
+        vertices.swap(vs);
+        parentIdx.swap(ps);
+        dist.swap(ds);
+        buildLookup();
+        return true;
+    }
+
+private:
+    static void append(std::vector<unsigned char>& out, const void* p, size_t n) {
+        const unsigned char* b = static_cast<const unsigned char*>(p);
+        out.insert(out.end(), b, b + n);
+    }
+
+    static bool read(const std::vector<unsigned char>& in, size_t& pos, void* p, size_t n) {
+        if (pos + n > in.size()) return false;
+        if (n) std::memcpy(p, in.data() + pos, n);
+        pos += n;
+        return true;
+    }
+};
+
+// Dijkstra that returns a sparse tree instead of dense dist/parent arrays.
+// The dense scratch lives in the workspace and is reused across calls.
+template <typename PQType, typename DistT = double>
+ShortestPathTree<DistT> runDijkstraTree(
+    const Graph& g,
+    int source,
+    DijkstraMetrics& metrics,
+    DijkstraWorkspace& ws
+) {
+    ws.prepare(g.numVertices());
+    auto& dist = ws.dist;
+    auto& parent = ws.parent;
+    auto& handles = ws.handles;
+
+    ShortestPathTree<DistT> tree;
+    tree.source = source;
+    tree.numGraphVertices = g.numVertices();
+
+    PQType pq;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    dist[source] = 0.0;
+    ws.touch(source);
+    handles[source] = pq.insert(0.0, source);
+    metrics.inserts++;
+
+    while (!pq.empty()) {
+        auto [d, u] = pq.extract_min();
+        metrics.extractMins++;
+        if (d > dist[u] || ws.settledIdx[u] >= 0) continue;
+
+        ws.settledIdx[u] = tree.size();
+        tree.vertices.push_back(u);
+        tree.parentIdx.push_back(parent[u] < 0 ? -1 : ws.settledIdx[parent[u]]);
+        tree.dist.push_back((DistT)d);
+
+        for (const auto& e : g.neighbors(u)) {
+            int v = e.to;
+            double nd = d + e.weight;
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                parent[v] = u;
+                if (handles[v] == nullptr) {
+                    ws.touch(v);
+                    handles[v] = pq.insert(nd, v);
+                    metrics.inserts++;
+                } else {
+                    pq.decrease_key(handles[v], nd);
+                    metrics.decreaseKeys++;
+                }
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    metrics.runtimeMs =
+        std::chrono::duration<double, std::milli>(end - start).count();
+
+    tree.buildLookup();
+    return tree;
+}
+
+template <typename PQType, typename DistT = double>
+ShortestPathTree<DistT> runDijkstraTree(const Graph& g, int source, DijkstraMetrics& metrics) {
+    DijkstraWorkspace ws;
+    return runDijkstraTree<PQType, DistT>(g, source, metrics, ws);
+}
+
+#endif // SHORTEST_PATH_TREE_H
@@ -0,0 +1,348 @@
+// skiplist_pq.h
+#ifndef SKIPLIST_PQ_H
+#define SKIPLIST_PQ_H
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <limits>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include "graph.h"
+#include "dijkstra.h"
+#include "concurrent_sssp.h"
+#include "graph_generators.h"
+#include "memory_tracker.h"
+
+// Lock-free skiplist priority queue for shared-frontier SSSP.
+//
+//   structure   Herlihy & Shavit's lock-free skiplist (Harris-style marked
+//               next pointers, one CAS per level link); duplicate keys are
+//               kept apart by a per-thread tie counter
+//   delete-min  walk level 0 from the head and claim the first unclaimed
+//               node with one atomic exchange (Herlihy & Shavit's SkipQueue)
+//   unlinking   claimed nodes are marked at once but, as in Lindén &
+//               Jonsson (2013), only physically unlinked every UnlinkBatch
+//               deletions per thread; walkers snip level 0 on the way, so
+//               threads do not all fight over the head pointers
+//   relaxed     SprayList-style (Alistarh et al., 2015) popRelaxed: a
+//               random descent of height log2(p) + 1 from the head lands
+//               among the first O(p log p) nodes and claims from there,
+//               spreading deleters over the front of the list
+//
+// Nodes are never reused or freed while the queue lives (per-thread bump
+// arenas charged to HeapNodes), so a traversal can always step through a
+// node another thread has just removed, with no hazard pointers or epochs.
+// Memory therefore grows with the number of pushes, which is bounded by
+// the number of successful relaxations of one search.
+
+struct SkipListStats {
+    long long insertCasFailures = 0; // level links lost to another thread
+    long long snipCasFailures = 0;   // find() restarts after a lost snip
+    long long claimFailures = 0;     // nodes claimed by someone else first
+    long long sprayFallbacks = 0;    // sprays that found nothing to claim
+    long long unlinkPasses = 0;      // batched physical unlink passes
+};
+
+class LockFreeSkipListPQ {
+    struct Arena;
+
+public:
+    static constexpr int MaxLevel = 24;
+    static constexpr int UnlinkBatch = 16;
+
+    struct Node {
+        double key;
+        uint64_t tie;
+        int value;
+        int topLevel;
+        std::atomic<bool> claimed;
+        std::atomic<uintptr_t>* next; // topLevel + 1 entries, low bit = mark
+    };
+
+    struct alignas(64) Context {
+        SplitMix64 rng;
+        int tid = 0;
+        uint64_t ties = 0;
+        int sinceUnlink = 0;
+        SkipListStats stats;
+        Arena* arena = nullptr;
+    };
+
+    // sprayThreads sets the spray height of popRelaxed (about log2 of the
+    // number of threads popping concurrently).
+    explicit LockFreeSkipListPQ(int sprayThreads = 1, uint64_t seed = 1)
+        : seed(seed) {
+        sprayHeight = 1;
+        while ((1 << sprayHeight) < sprayThreads && sprayHeight < MaxLevel - 1) ++sprayHeight;
+        head = makeSentinel(-std::numeric_limits<double>::infinity(), 0);
+        tail = makeSentinel(std::numeric_limits<double>::infinity(), UINT64_MAX);
+        for (int l = 0; l < MaxLevel; ++l) head->next[l].store((uintptr_t)tail);
+    }
+
+    ~LockFreeSkipListPQ() {
+        std::lock_guard<std::mutex> guard(arenaLock);
+        for (auto& a : arenas) a->release();
+        sentinels.release();
+    }
+
+    LockFreeSkipListPQ(const LockFreeSkipListPQ&) = delete;
+    LockFreeSkipListPQ& operator=(const LockFreeSkipListPQ&) = delete;
+
+    // Thread-safe; each thread needs its own context.
+    Context makeContext(int tid) {
+        Context ctx;
+        ctx.rng = SplitMix64(SplitMix64::mix(seed + 1 + tid));
+        ctx.tid = tid;
+        std::lock_guard<std::mutex> guard(arenaLock);
+        arenas.emplace_back(new Arena());
+        ctx.arena = arenas.back().get();
+        return ctx;
+    }
+
+    void push(double key, int value, Context& ctx) {
+        int top = randomLevel(ctx);
+        Node* node = newNode(*ctx.arena, key, ((++ctx.ties) << 16) | (uint64_t)(ctx.tid & 0xffff),
+                             value, top);
+        Node* preds[MaxLevel];
+        Node* succs[MaxLevel];
+        while (true) {
+            find(node->key, node->tie, preds, succs, ctx);
+            for (int l = 0; l <= top; ++l) node->next[l].store((uintptr_t)succs[l], std::memory_order_relaxed);
+            uintptr_t expected = (uintptr_t)succs[0];
+            if (preds[0]->next[0].compare_exchange_strong(expected, (uintptr_t)node)) break;
+            ctx.stats.insertCasFailures++;
+        }
+        // Upper levels are hints; give up as soon as the node is deleted.
+        for (int l = 1; l <= top; ++l) {
+            while (true) {
+                uintptr_t cur = node->next[l].load();
+                if (marked(cur)) return;
+                if (ptr(cur) != succs[l] &&
+                    !node->next[l].compare_exchange_strong(cur, (uintptr_t)succs[l])) {
+                    continue; // marked meanwhile: caught above
+                }
+                uintptr_t expected = (uintptr_t)succs[l];
+                if (preds[l]->next[l].compare_exchange_strong(expected, (uintptr_t)node)) break;
+                ctx.stats.insertCasFailures++;
+                find(node->key, node->tie, preds, succs, ctx);
+            }
+        }
+    }
+
+    // Exact delete-min: the smallest node not yet claimed.
+    bool tryPop(std::pair<double,int>& out, Context& ctx) {
+        return claimFrom(head, out, ctx);
+    }
+
+    // Relaxed delete-min: spray, then claim the first free node after the
+    // landing point; falls back to the exact walk if the spray overshoots.
+    bool popRelaxed(std::pair<double,int>& out, Context& ctx) {
+        Node* x = head;
+        for (int l = sprayHeight; l >= 0; --l) {
+            int jumps = (int)ctx.rng.below(sprayHeight + 1);
+            for (int j = 0; j < jumps; ++j) {
+                Node* nx = ptr(x->next[l].load());
+                if (nx == tail) break;
+                x = nx;
+            }
+        }
+        if (x != head && claimFrom(x, out, ctx)) return true;
+        if (x != head) ctx.stats.sprayFallbacks++;
+        return claimFrom(head, out, ctx);
+    }
+
+private:
+    struct Arena {
+        std::vector<std::pair<char*, size_t>> chunks;
+        size_t used = 0;
+
+        void* allocate(size_t bytes) {
+            bytes = (bytes + 15) & ~size_t(15);
+            if (chunks.empty() || used + bytes > chunks.back().second) {
+                size_t size = std::max<size_t>(bytes, ChunkBytes);
+                chunks.emplace_back(static_cast<char*>(trackedAllocate(MemComponent::HeapNodes, size)), size);
+                used = 0;
+            }
+            void* p = chunks.back().first + used;
+            used += bytes;
+            return p;
+        }
+
+        void release() {
+            for (auto& c : chunks) trackedDeallocate(MemComponent::HeapNodes, c.first, c.second);
+            chunks.clear();
+            used = 0;
+        }
+    };
+    static constexpr size_t ChunkBytes = 1 << 20;
+
+    uint64_t seed;
+    int sprayHeight;
+    Node* head;
+    Node* tail;
+    std::mutex arenaLock;
+    std::vector<std::unique_ptr<Arena>> arenas;
+    Arena sentinels;
+
+    static Node* ptr(uintptr_t v) { return reinterpret_cast<Node*>(v & ~uintptr_t(1)); }
+    static bool marked(uintptr_t v) { return (v & 1) != 0; }
+
+    static bool less(const Node* x, double key, uint64_t tie) {
+        return x->key < key || (x->key == key && x->tie < tie);
+    }
+
+    static Node* newNode(Arena& arena, double key, uint64_t tie, int value, int top) {
+        size_t bytes = sizeof(Node) + (top + 1) * sizeof(std::atomic<uintptr_t>);
+        char* mem = static_cast<char*>(arena.allocate(bytes));
+        Node* x = ::new (mem) Node;
+        x->key = key;
+        x->tie = tie;
+        x->value = value;
+        x->topLevel = top;
+        x->claimed.store(false, std::memory_order_relaxed);
+        x->next = reinterpret_cast<std::atomic<uintptr_t>*>(mem + sizeof(Node));
+        for (int l = 0; l <= top; ++l) ::new (&x->next[l]) std::atomic<uintptr_t>(0);
+        return x;
+    }
+
+    Node* makeSentinel(double key, uint64_t tie) {
+        Node* x = newNode(sentinels, key, tie, -1, MaxLevel - 1);
+        x->claimed.store(true, std::memory_order_relaxed);
+        return x;
+    }
+
+    int randomLevel(Context& ctx) {
+        uint64_t r = ctx.rng.next() | (1ull << (MaxLevel - 1));
+        return __builtin_ctzll(r);
+    }
+
+    // Fills preds/succs around (key, tie) at every level, snipping marked
+    // nodes on the way; restarts when a snip loses its CAS.
+    void find(double key, uint64_t tie, Node** preds, Node** succs, Context& ctx) {
+    retry:
+        Node* pred = head;
+        for (int l = MaxLevel - 1; l >= 0; --l) {
+            Node* curr = ptr(pred->next[l].load());
+            while (true) {
+                uintptr_t cn = curr->next[l].load();
+                while (marked(cn)) {
+                    uintptr_t expected = (uintptr_t)curr;
+                    if (!pred->next[l].compare_exchange_strong(expected, cn & ~uintptr_t(1))) {
+                        ctx.stats.snipCasFailures++;
+                        goto retry;
+                    }
+                    curr = ptr(cn);
+                    cn = curr->next[l].load();
+                }
+                if (curr != tail && less(curr, key, tie)) {
+                    pred = curr;
+                    curr = ptr(cn);
+                } else {
+                    break;
+                }
+            }
+            preds[l] = pred;
+            succs[l] = curr;
+        }
+    }
+
+    // Claims the first unclaimed node after start along level 0, helping to
+    // snip marked nodes it walks over.
+    bool claimFrom(Node* start, std::pair<double,int>& out, Context& ctx) {
+        Node* pred = start;
+        Node* curr = ptr(start->next[0].load());
+        while (curr != tail) {
+            uintptr_t cn = curr->next[0].load();
+            if (marked(cn)) {
+                uintptr_t expected = (uintptr_t)curr;
+                pred->next[0].compare_exchange_strong(expected, cn & ~uintptr_t(1));
+                curr = ptr(cn);
+                continue;
+            }
+            if (!curr->claimed.load(std::memory_order_relaxed)) {
+                if (!curr->claimed.exchange(true)) {
+                    out = {curr->key, curr->value};
+                    remove(curr, ctx);
+                    return true;
+                }
+                ctx.stats.claimFailures++;
+            }
+            pred = curr;
+            curr = ptr(cn);
+        }
+        return false;
+    }
+
+    // Logical delete (mark every level, top down) by the claiming thread;
+    // the physical unlink is batched.
+    void remove(Node* x, Context& ctx) {
+        for (int l = x->topLevel; l >= 0; --l) {
+            uintptr_t cur = x->next[l].load();
+            while (!marked(cur) && !x->next[l].compare_exchange_weak(cur, cur | 1)) {
+            }
+        }
+        if (++ctx.sinceUnlink >= UnlinkBatch) {
+            ctx.sinceUnlink = 0;
+            ctx.stats.unlinkPasses++;
+            Node* preds[MaxLevel];
+            Node* succs[MaxLevel];
+            find(x->key, x->tie, preds, succs, ctx);
+        }
+    }
+};
+
+// Shared-frontier SSSP on the lock-free skiplist (see runConcurrentSSSP).
+// relaxed selects popRelaxed (SprayList) instead of the exact delete-min.
+class SkipListFrontier {
+public:
+    using Context = LockFreeSkipListPQ::Context;
+
+    SkipListFrontier(LockFreeSkipListPQ& pq, bool relaxed) : pq(pq), relaxed(relaxed) {}
+
+    Context makeContext(int tid) { return pq.makeContext(tid); }
+    void push(double key, int value, Context& ctx) { pq.push(key, value, ctx); }
+    bool tryPop(std::pair<double,int>& out, Context& ctx) {
+        return relaxed ? pq.popRelaxed(out, ctx) : pq.tryPop(out, ctx);
+    }
+
+private:
+    LockFreeSkipListPQ& pq;
+    bool relaxed;
+};
+
+struct SkipListSearchStats {
+    ConcurrentSearchStats search;
+    SkipListStats queue;
+};
+
+inline DijkstraResult runDijkstraSkipList(const Graph& g, int source, int numThreads,
+                                          DijkstraMetrics& metrics,
+                                          SkipListSearchStats* statsOut = nullptr,
+                                          bool relaxed = true, uint64_t seed = 1) {
+    if (numThreads <= 0) numThreads = 1;
+    LockFreeSkipListPQ pq(numThreads, seed);
+    SkipListFrontier frontier(pq, relaxed);
+    std::vector<SkipListFrontier::Context> contexts;
+    ConcurrentSearchStats search;
+    DijkstraResult res = runConcurrentSSSP(g, source, numThreads, frontier, contexts, metrics, search);
+
+    if (statsOut) {
+        SkipListSearchStats total;
+        total.search = search;
+        for (const auto& ctx : contexts) {
+            total.queue.insertCasFailures += ctx.stats.insertCasFailures;
+            total.queue.snipCasFailures += ctx.stats.snipCasFailures;
+            total.queue.claimFailures += ctx.stats.claimFailures;
+            total.queue.sprayFallbacks += ctx.stats.sprayFallbacks;
+            total.queue.unlinkPasses += ctx.stats.unlinkPasses;
+        }
+        *statsOut = total;
+    }
+    return res;
+}
+
+#endif // SKIPLIST_PQ_H
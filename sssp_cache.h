@@ -0,0 +1,248 @@
+// sssp_cache.h
+#ifndef SSSP_CACHE_H
+#define SSSP_CACHE_H
+
+#include <vector>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <cstddef>
+#include "graph.h"
+#include "dijkstra.h"
+
+// Compressed shortest-path tree: only reached vertices, stored parent-first
+// (order[0] is the source). Distances are not stored; they are rebuilt
+// exactly from the edge weights, which is what Dijkstra summed in the first
+// place. 8 bytes per reached vertex instead of 12 per vertex.
+struct CompressedTree {
+    std::vector<int> order;
+    std::vector<int> parentOf; // parentOf[i] = parent vertex of order[i]
+
+    size_t bytes() const {
+        return sizeof(CompressedTree)
+             + order.capacity() * sizeof(int)
+             + parentOf.capacity() * sizeof(int);
+    }
+};
+
+inline CompressedTree compressTree(const DijkstraResult& res, int source) {
+    int n = (int)res.parent.size();
+    // children in CSR form, then BFS over the tree from the source
+    std::vector<int> start(n + 1, 0);
+    for (int v = 0; v < n; ++v) {
+        if (res.parent[v] >= 0) start[res.parent[v] + 1]++;
+    }
+    for (int v = 0; v < n; ++v) start[v + 1] += start[v];
+    std::vector<int> children(start[n]);
+    std::vector<int> fill(start.begin(), start.end() - 1);
+    for (int v = 0; v < n; ++v) {
+        if (res.parent[v] >= 0) children[fill[res.parent[v]]++] = v;
+    }
+
+    CompressedTree t;
+    t.order.reserve(start[n] + 1);
+    t.order.push_back(source);
+    for (size_t i = 0; i < t.order.size(); ++i) {
+        int u = t.order[i];
+        for (int k = start[u]; k < start[u + 1]; ++k) t.order.push_back(children[k]);
+    }
+    t.parentOf.resize(t.order.size());
+    t.parentOf[0] = -1;
+    for (size_t i = 1; i < t.order.size(); ++i) t.parentOf[i] = res.parent[t.order[i]];
+    return t;
+}
+
+inline DijkstraResult decompressTree(const Graph& g, const CompressedTree& t) {
+    int n = g.numVertices();
+    DijkstraResult res{DijkstraBuffer<double>(n, std::numeric_limits<double>::infinity()),
+                       DijkstraBuffer<int>(n, -1)};
+    if (t.order.empty()) return res;
+    res.dist[t.order[0]] = 0.0;
+    for (size_t i = 1; i < t.order.size(); ++i) {
+        int v = t.order[i];
+        int p = t.parentOf[i];
+        // cheapest p->v edge is the one Dijkstra relaxed
+        double w = std::numeric_limits<double>::infinity();
+        for (const auto& e : g.neighbors(p)) {
+            if (e.to == v && e.weight < w) w = e.weight;
+        }
+        res.dist[v] = res.dist[p] + w;
+        res.parent[v] = p;
+    }
+    return res;
+}
+
+// Thread-safe LRU cache of shortest-path trees keyed by source, bounded by a
+// memory budget. Everything is dropped as soon as the graph's version changes.
+template <typename PQType>
+class SSSPCache {
+public:
+    SSSPCache(const Graph& graph, size_t memoryBudgetBytes)
+        : g(graph), budget(memoryBudgetBytes), usedBytes(0),
+          graphVersion(graph.version()),
+          nHits(0), nMisses(0), nEvictions(0), nInvalidations(0) {}
+
+    DijkstraResult query(int source, DijkstraMetrics& metrics) {
+        std::shared_ptr<const CompressedTree> hit;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            checkVersion();
+            auto it = index.find(source);
+            if (it != index.end()) {
+                lru.splice(lru.begin(), lru, it->second);
+                hit = it->second->tree;
+                ++nHits;
+            } else {
+                ++nMisses;
+            }
+        }
+
+        // decompress / compute outside the lock so other queries are not blocked
+        if (hit) {
+            auto start = std::chrono::high_resolution_clock::now();
+            DijkstraResult res = decompressTree(g, *hit);
+            auto end = std::chrono::high_resolution_clock::now();
+            metrics.runtimeMs =
+                std::chrono::duration<double, std::milli>(end - start).count();
+            return res;
+        }
+
+        unsigned long long computedOn = g.version();
+        DijkstraResult res = runDijkstra<PQType>(g, source, metrics);
+        auto tree = std::make_shared<const CompressedTree>(compressTree(res, source));
+
+        std::lock_guard<std::mutex> lock(mtx);
+        checkVersion();
+        size_t bytes = tree->bytes() + entryOverhead();
+        if (graphVersion == computedOn && index.find(source) == index.end()
+            && bytes <= budget) {
+            lru.push_front(Entry{source, std::move(tree), bytes});
+            index[source] = lru.begin();
+            usedBytes += bytes;
+            evictToBudget();
+        }
+        return res;
+    }
+
+    void invalidate() {
+        std::lock_guard<std::mutex> lock(mtx);
+        clearLocked();
+    }
+
+    void setMemoryBudget(size_t bytes) {
+        std::lock_guard<std::mutex> lock(mtx);
+        budget = bytes;
+        evictToBudget();
+    }
+
+    // For sizing
+    long long getHits() const { return nHits.load(); }
+    long long getMisses() const { return nMisses.load(); }
+    long long getEvictions() const { return nEvictions.load(); }
+    long long getInvalidations() const { return nInvalidations.load(); }
+    double getHitRate() const {
+        long long total = getHits() + getMisses();
+        return total ? (double)getHits() / (double)total : 0.0;
+    }
+    size_t getBytesUsed() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return usedBytes;
+    }
+    size_t getNumEntries() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return lru.size();
+    }
+
+private:
+    struct Entry {
+        int source;
+        std::shared_ptr<const CompressedTree> tree;
+        size_t bytes;
+    };
+
+    const Graph& g;
+    size_t budget;
+    size_t usedBytes;
+    unsigned long long graphVersion;
+    std::list<Entry> lru; // front = most recently used
+    std::unordered_map<int, typename std::list<Entry>::iterator> index;
+    mutable std::mutex mtx;
+
+    std::atomic<long long> nHits;
+    std::atomic<long long> nMisses;
+    std::atomic<long long> nEvictions;
+    std::atomic<long long> nInvalidations;
+
+    static size_t entryOverhead() {
+        // list node + hash map node, roughly
+        return sizeof(Entry) + 2 * sizeof(void*)
+             + sizeof(int) + sizeof(void*) * 3;
+    }
+
+    void checkVersion() {
+        if (g.version() != graphVersion) {
+            clearLocked();
+            graphVersion = g.version();
+        }
+    }
+
+    void clearLocked() {
+        if (!lru.empty()) ++nInvalidations;
+        lru.clear();
+        index.clear();
+        usedBytes = 0;
+    }
+
+    void evictToBudget() {
+        while (usedBytes > budget && !lru.empty()) {
+            Entry& victim = lru.back();
+            usedBytes -= victim.bytes;
+            index.erase(victim.source);
+            lru.pop_back();
+            ++nEvictions;
+        }
+    }
+};
+
+// Same shape as runDijkstraMultiSource, but every query goes through the cache
+// and the results are kept.
+template <typename PQType>
+void runDijkstraMultiSourceCached(
+    SSSPCache<PQType>& cache,
+    const std::vector<int>& sources,
+    int numThreads,
+    std::vector<DijkstraResult>& resultsOut,
+    std::vector<DijkstraMetrics>& metricsOut,
+    double& totalRuntimeMs
+) {
+    if (numThreads <= 0) numThreads = 1;
+    resultsOut.assign(sources.size(), DijkstraResult{});
+    metricsOut.assign(sources.size(), DijkstraMetrics{});
+
+    auto worker = [&](int tid) {
+        for (size_t i = tid; i < sources.size(); i += numThreads) {
+            resultsOut[i] = cache.query(sources[i], metricsOut[i]);
+        }
+    };
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    auto t2 = std::chrono::high_resolution_clock::now();
+    totalRuntimeMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+}
+
+#endif // SSSP_CACHE_H
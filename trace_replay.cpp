@@ -0,0 +1,193 @@
+// trace_replay.cpp
+// Record the priority queue calls of a real Dijkstra run, then replay them
+// against any heap.
+//
+// Build: g++ -O2 -std=c++17 trace_replay.cpp -o trace_replay
+// Usage:
+//   ./trace_replay record --graph Hongkong.road-d --source 0 --out hk.pqt
+//   ./trace_replay replay --trace hk.pqt --heaps binary,fibonacci --reps 10
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+
+#include "graph.h"
+#include "dijkstra.h"
+#include "heap_registry.h"
+#include "pq_trace.h"
+#include "bench_stats.h"
+#include "latency_histogram.h"
+
+static void printUsage() {
+    std::cerr <<
+        "Usage:\n"
+        "  ./trace_replay record --graph <file.road-d> --out <trace.pqt>\n"
+        "                        [--source S] [--heap NAME] [--directed]\n"
+        "  ./trace_replay replay --trace <trace.pqt> [--heaps a,b,...]\n"
+        "                        [--reps N] [--latency PREFIX]\n";
+}
+
+static std::vector<std::string> splitList(const std::string& s) {
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) out.push_back(item);
+    }
+    return out;
+}
+
+static int record(const std::string& graphPath, bool directed, int source,
+                  const std::string& heap, const std::string& outPath) {
+    Graph g;
+    if (!g.loadRoadD(graphPath, !directed)) {
+        return 1;
+    }
+    if (source < 0 || source >= g.numVertices()) {
+        std::cerr << "Error: source " << source << " out of range\n";
+        return 1;
+    }
+
+    PQTrace& trace = PQTrace::threadDefault();
+    trace.clear();
+    DijkstraMetrics metrics;
+    bool known = withHeap(heap, [&](auto tag) {
+        using PQ = typename decltype(tag)::type;
+        runDijkstra<TracingPQ<PQ>>(g, source, metrics);
+    });
+    if (!known) {
+        std::cerr << "Error: unknown heap '" << heap << "'\n";
+        return 1;
+    }
+    if (!trace.save(outPath)) {
+        return 1;
+    }
+
+    std::cout << "Recorded " << trace.size() << " operations ("
+              << metrics.inserts << " inserts, " << metrics.extractMins
+              << " extract-mins, " << metrics.decreaseKeys << " decrease-keys) to "
+              << outPath << "\n";
+    return 0;
+}
+
+static int replay(const std::string& tracePath, const std::vector<std::string>& heaps,
+                  int reps, const std::string& latencyPrefix) {
+    PQTrace trace;
+    if (!trace.load(tracePath)) {
+        return 1;
+    }
+    std::cerr << "Loaded trace: " << trace.size() << " operations\n";
+
+    std::ofstream summary, hist;
+    if (!latencyPrefix.empty()) {
+        summary.open(latencyPrefix + "_summary.csv");
+        hist.open(latencyPrefix + "_hist.csv");
+        if (!summary.is_open() || !hist.is_open()) {
+            std::cerr << "Error: could not open " << latencyPrefix << "_*.csv for writing.\n";
+            return 1;
+        }
+        summary << "heap,op,count,mean_ns,p50_ns,p90_ns,p99_ns,p999_ns,p9999_ns,max_ns\n";
+        hist << "heap,op,bucket_low_ns,bucket_high_ns,count\n";
+    }
+
+    std::cout << "heap,reps,median_ms,mean_ms,stddev_ms,p95_ms,ci95_low_ms,ci95_high_ms,"
+                 "inserts,extractMins,decreaseKeys,keyMismatches\n";
+    for (const auto& h : heaps) {
+        bool known = withHeap(h, [&](auto tag) {
+            using PQ = typename decltype(tag)::type;
+            std::vector<double> samples;
+            ReplayResult last;
+            for (int r = 0; r < reps; ++r) {
+                last = replayTrace<PQ>(trace);
+                samples.push_back(last.runtimeMs);
+            }
+            SampleStats s = summarize(samples);
+            std::cout << h << "," << s.count << "," << s.median << "," << s.mean << ","
+                      << s.stddev << "," << s.p95 << "," << s.ci95Low << "," << s.ci95High << ","
+                      << last.inserts << "," << last.extractMins << ","
+                      << last.decreaseKeys << "," << last.keyMismatches << "\n";
+
+            if (!latencyPrefix.empty()) {
+                LatencyProfile profile;
+                InstrumentedPQ<PQ> pq(profile);
+                replayTrace(trace, pq);
+                const std::pair<const char*, const LatencyHistogram*> ops[] = {
+                    {"insert", &profile.insert},
+                    {"extract_min", &profile.extractMin},
+                    {"decrease_key", &profile.decreaseKey}};
+                for (const auto& op : ops) {
+                    summary << h << ",";
+                    writeLatencySummaryRow(summary, op.first, *op.second);
+                    std::ostringstream tmp;
+                    writeLatencyDistribution(tmp, op.first, *op.second);
+                    std::istringstream lines(tmp.str());
+                    std::string line;
+                    while (std::getline(lines, line)) hist << h << "," << line << "\n";
+                }
+            }
+        });
+        if (!known) {
+            std::cerr << "Error: unknown heap '" << h << "'\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+    std::string mode = argv[1];
+
+    std::string graphPath, outPath, tracePath, latencyPrefix;
+    std::string heap = "binary";
+    std::vector<std::string> heaps = allHeapNames();
+    bool directed = false;
+    int source = 0;
+    int reps = 5;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        try {
+            if (a == "--graph" && hasValue) graphPath = argv[++i];
+            else if (a == "--out" && hasValue) outPath = argv[++i];
+            else if (a == "--trace" && hasValue) tracePath = argv[++i];
+            else if (a == "--source" && hasValue) source = std::stoi(argv[++i]);
+            else if (a == "--heap" && hasValue) heap = argv[++i];
+            else if (a == "--heaps" && hasValue) heaps = splitList(argv[++i]);
+            else if (a == "--reps" && hasValue) reps = std::stoi(argv[++i]);
+            else if (a == "--latency" && hasValue) latencyPrefix = argv[++i];
+            else if (a == "--directed") directed = true;
+            else {
+                std::cerr << "Error: unknown or incomplete option " << a << "\n";
+                printUsage();
+                return 1;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Error: invalid value for " << a << "\n";
+            return 1;
+        }
+    }
+    if (reps < 1) reps = 1;
+
+    if (mode == "record") {
+        if (graphPath.empty() || outPath.empty()) {
+            printUsage();
+            return 1;
+        }
+        return record(graphPath, directed, source, heap, outPath);
+    }
+    if (mode == "replay") {
+        if (tracePath.empty()) {
+            printUsage();
+            return 1;
+        }
+        return replay(tracePath, heaps, reps, latencyPrefix);
+    }
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,101 @@
+// workload_gen.cpp
+// Generate a seeded, reusable query workload for a graph.
+//
+// Build: g++ -O2 -std=c++17 workload_gen.cpp -o workload_gen
+// Usage:
+//   ./workload_gen rank   --graph Hongkong.road-d --sources 100 --out hk_rank.qwl
+//   ./workload_gen random --graph Hongkong.road-d --count 1000 --out hk_random.qwl
+//   ./workload_gen mixed  --gen grid:1000x1000 --count 1000 --local-fraction 0.7
+//                         --local-rank 4096 --out grid_mixed.qwl
+#include <iostream>
+#include <string>
+
+#include "graph.h"
+#include "graph_generators.h"
+#include "query_workload.h"
+
+static void printUsage() {
+    std::cerr <<
+        "Usage: ./workload_gen <rank|random|mixed> (--graph FILE | --gen SPEC) --out FILE\n"
+        "  --directed               load / generate a directed graph\n"
+        "  --seed S                 workload seed (default 1); also seeds --gen\n"
+        "  --sources N              rank: number of random sources (default 100)\n"
+        "  --min-log K, --max-log K rank: ranks 2^K range (default 1 .. log2 n)\n"
+        "  --count N                random / mixed: number of queries (default 1000)\n"
+        "  --local-fraction F       mixed: share of local queries (default 0.5)\n"
+        "  --local-rank R           mixed: local targets among first R settled (default 1024)\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+    std::string kind = argv[1];
+    std::string graphPath, genSpec, outPath;
+    bool directed = false;
+    unsigned long long seed = 1;
+    int sources = 100, count = 1000, minLog = 1, maxLog = -1;
+    double localFraction = 0.5;
+    long long localRank = 1024;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        try {
+            if (a == "--graph" && hasValue) graphPath = argv[++i];
+            else if (a == "--gen" && hasValue) genSpec = argv[++i];
+            else if (a == "--out" && hasValue) outPath = argv[++i];
+            else if (a == "--seed" && hasValue) seed = std::stoull(argv[++i]);
+            else if (a == "--sources" && hasValue) sources = std::stoi(argv[++i]);
+            else if (a == "--min-log" && hasValue) minLog = std::stoi(argv[++i]);
+            else if (a == "--max-log" && hasValue) maxLog = std::stoi(argv[++i]);
+            else if (a == "--count" && hasValue) count = std::stoi(argv[++i]);
+            else if (a == "--local-fraction" && hasValue) localFraction = std::stod(argv[++i]);
+            else if (a == "--local-rank" && hasValue) localRank = std::stoll(argv[++i]);
+            else if (a == "--directed") directed = true;
+            else {
+                std::cerr << "Error: unknown or incomplete option " << a << "\n";
+                printUsage();
+                return 1;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Error: invalid value for " << a << "\n";
+            return 1;
+        }
+    }
+    if (outPath.empty() || graphPath.empty() == genSpec.empty()) {
+        printUsage();
+        return 1;
+    }
+    if (minLog < 0 || minLog > 62 || maxLog > 62) {
+        std::cerr << "Error: --min-log and --max-log must be in 0 .. 62\n";
+        return 1;
+    }
+
+    Graph g;
+    if (!genSpec.empty()) {
+        if (!generateGraphFromSpec(g, genSpec, seed, !directed)) return 1;
+    } else if (!g.loadRoadD(graphPath, !directed)) {
+        return 1;
+    }
+
+    QueryWorkload w;
+    if (kind == "rank") {
+        w = generateRankQueries(g, sources, seed, minLog, maxLog);
+    } else if (kind == "random") {
+        w = generateRandomPairs(g, count, seed);
+    } else if (kind == "mixed") {
+        w = generateMixedQueries(g, count, localFraction, localRank, seed);
+    } else {
+        std::cerr << "Error: unknown workload kind '" << kind << "'\n";
+        printUsage();
+        return 1;
+    }
+    if (!w.save(outPath)) {
+        return 1;
+    }
+    std::cout << "Wrote " << w.size() << " " << kind << " queries ("
+              << w.sources().size() << " distinct sources) to " << outPath << "\n";
+    return 0;
+}